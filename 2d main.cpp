@@ -3,8 +3,12 @@
 
 #include <iostream>
 #include <cmath>
+#include <string>
+#include <vector>
 
 #include "../Header/Util.h"
+#include "../Header/TextureAtlas.h"
+#include "../Header/ProgramCache.h"
 
 // =============================
 //  MEHANIKA KANDŽE – VARIJABLE
@@ -128,7 +132,7 @@ int main()
     glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
 
     // === SHADERI
-    unsigned int shader = createShader("basic.vert", "basic.frag");
+    unsigned int shader = loadShaderProgram("basic.vert", "basic.frag");
     glUseProgram(shader);
 
     int locTex = glGetUniformLocation(shader, "uTex");
@@ -136,7 +140,17 @@ int main()
     int locScale = glGetUniformLocation(shader, "uScale");
     int locColor = glGetUniformLocation(shader, "uColor");
     int locUseTex = glGetUniformLocation(shader, "uUseTexture");
-    int signatureTex = loadImageToTexture("Resources/signature.png");
+    // Svi sprajtovi su u jednom atlasu (vidi TextureAtlas.h): ceo frejm crta sa jednom vezanom teksturom
+    enum Sprite { SPRITE_SIGNATURE, SPRITE_TOY1, SPRITE_TOY2, SPRITE_CLOSED_CLAW, SPRITE_OPEN_CLAW, SPRITE_ROPE, SPRITE_SLOT, SPRITE_COUNT };
+    const std::vector<std::string> spritePaths = {
+        "Resources/signature.png", "Resources/toy1.png", "Resources/toy2.png", "Resources/closed-claw.png",
+        "Resources/claw.jpg", "Resources/rope.jpg", "Resources/slot.jpg"
+    };
+    AtlasImage atlas;
+    if (!buildTextureAtlas(spritePaths, AtlasOptions(), atlas))
+        return endProgram("Atlas sprajtova nije napravljen!");
+    unsigned int atlasTex = createAtlasTexture(atlas);
+    atlas.pixels = std::vector<unsigned char>();  // pikseli su na GPU-u, UV pravougaonici ostaju
 
 
     glUniform1i(locTex, 0);
@@ -152,6 +166,19 @@ int main()
 
     unsigned int indices[] = { 0,1,2, 0,2,3 };
 
+    // Quad 0 je ceo [0,1] (za netekstuirane pravougaonike), a quad 1 + i isti pravougaonik sa UV-jem sprajta i u atlasu
+    std::vector<float> quadData(quadVertices, quadVertices + 16);
+    for (const AtlasSprite& sprite : atlas.sprites)
+    {
+        for (int v = 0; v < 4; v++)
+        {
+            quadData.push_back(quadVertices[v * 4 + 0]);
+            quadData.push_back(quadVertices[v * 4 + 1]);
+            quadData.push_back(sprite.u0 + quadVertices[v * 4 + 2] * (sprite.u1 - sprite.u0));
+            quadData.push_back(sprite.v0 + quadVertices[v * 4 + 3] * (sprite.v1 - sprite.v0));
+        }
+    }
+
     unsigned int VAO, VBO, EBO;
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -160,8 +187,8 @@ int main()
     glBindVertexArray(VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices),
-        quadVertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, quadData.size() * sizeof(float),
+        quadData.data(), GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices),
@@ -208,12 +235,10 @@ int main()
     glBindVertexArray(0);
     // === END 1/3 ===
     // === TEKSTURE
-    unsigned int toy1Tex = loadImageToTexture("Resources/toy1.png");
-    unsigned int toy2Tex = loadImageToTexture("Resources/toy2.png");
-    unsigned int closedClawTex = loadImageToTexture("Resources/closed-claw.png");
-    unsigned int openClawTex = loadImageToTexture("Resources/claw.jpg");
-    unsigned int ropeTex = loadImageToTexture("Resources/rope.jpg");
-    unsigned int slotTex = loadImageToTexture("Resources/slot.jpg");
+    // Crta sprajt iz atlasa preko VAO-a pravougaonika (quad 1 + sprite u VBO-u)
+    auto drawSprite = [](int sprite) {
+        glDrawElementsBaseVertex(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0, 4 * (1 + sprite));
+    };
 
     double lastTime = glfwGetTime();
 
@@ -581,49 +606,42 @@ int main()
         glUniform2f(locOffset, 0.0f, 0.10f);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 
-        // 2) IGRAČKE
+        // 2) IGRAČKE – od ovde svi sprajtovi dolaze iz atlasa, vezanog jednom za ceo frejm
+        glBindTexture(GL_TEXTURE_2D, atlasTex);
         glUniform1i(locUseTex, GL_TRUE);
         glUniform4f(locColor, 1, 1, 1, 1);
 
         if (!toy1Collected)
         {
-            glBindTexture(GL_TEXTURE_2D, toy1Tex);
             glUniform2f(locScale, 0.20f, 0.20f);
             glUniform2f(locOffset, toy1X, toy1Y);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            drawSprite(SPRITE_TOY1);
         }
 
         if (!toy2Collected)
         {
-            glBindTexture(GL_TEXTURE_2D, toy2Tex);
             glUniform2f(locScale, 0.20f, 0.20f);
             glUniform2f(locOffset, toy2X, toy2Y);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+            drawSprite(SPRITE_TOY2);
         }
 
         // 3) KONOPAC
-        glBindTexture(GL_TEXTURE_2D, ropeTex);
         glUniform2f(locScale, 0.03f, ropeLength);
         glUniform2f(locOffset, clawX, 0.90f - ropeLength / 2.0f);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        drawSprite(SPRITE_ROPE);
 
         // 4) KANDŽA
-        if (!gameRunning || holdingToy)
-            glBindTexture(GL_TEXTURE_2D, closedClawTex);
-        else
-            glBindTexture(GL_TEXTURE_2D, openClawTex);
         glUniform2f(locScale, 0.18f, 0.22f);
         glUniform2f(locOffset, clawX, clawY);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        drawSprite((!gameRunning || holdingToy) ? SPRITE_CLOSED_CLAW : SPRITE_OPEN_CLAW);
 
         // 5) SLOT
         glBindVertexArray(VAO);
         glUniform1i(locUseTex, GL_TRUE);
         glUniform4f(locColor, 1, 1, 1, 1);
-        glBindTexture(GL_TEXTURE_2D, slotTex);
         glUniform2f(locScale, 0.25f, 0.45f);
         glUniform2f(locOffset, 0.0f, -0.62f);
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        drawSprite(SPRITE_SLOT);
 
         // 6) RUPA
         glBindVertexArray(circleVAO);
@@ -669,12 +687,10 @@ int main()
         glUniform1i(locUseTex, GL_TRUE);
         glUniform4f(locColor, 1.0f, 1.0f, 1.0f, 0.55f);
 
-        glBindTexture(GL_TEXTURE_2D, signatureTex);
-
         glUniform2f(locScale, 0.85f, 0.50f);
         glUniform2f(locOffset, -0.75f, 0.85f);
 
-        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        drawSprite(SPRITE_SIGNATURE);
 
         // ============================================================
         // KRAJ FREJMA
@@ -707,6 +723,7 @@ int main()
     glfwDestroyCursor(cursorCoin);
     glfwDestroyCursor(cursorLever);
 
+    glDeleteTextures(1, &atlasTex);
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
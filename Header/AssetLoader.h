@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include "Model.h"
+#include "Util.h"
+
+// Paralelno učitavanje resursa pri pokretanju: dekodiranje slika i parsiranje .obj fajlova ide na radnim
+// nitima, a GL objekti (VAO/VBO/kursori) se prave na glavnoj niti čim pojedini resurs bude spreman.
+// Ukupno vreme je tako ograničeno najsporijim resursom umesto zbirom svih.
+//
+// Upotreba:
+//   AssetLoader loader;
+//   loader.addOBJ("Resources/claw.obj", claw);
+//   loader.addCursor("Resources/coin.png", cursorCoin);
+//   loader.run();  // vraća se kad su svi resursi učitani i poslati na GPU
+class AssetLoader {
+public:
+    // Opšti zadatak: work() na radnoj niti (bez GL poziva), upload() na glavnoj niti posle njega
+    void add(const std::string& name, std::function<void()> work, std::function<void()> upload);
+
+    // Rezultat se upisuje u prosleđene promenljive, koje moraju živeti do kraja run()
+    void addOBJ(const char* filePath, OBJModel& model, bool optimize = true);
+    // size: jedna od CURSOR_SIZES (vidi CursorCache.h), obično cursorSizeForScale(content scale prozora)
+    void addCursor(const char* filePath, GLFWcursor*& cursor, int size = 32);
+
+    // Pokreće radne niti (threadCount = 0: broj jezgara, najviše jedna po resursu) i na pozivajućoj niti
+    // izvršava upload redom kojim se resursi završavaju; ispisuje vreme za svaki resurs i ukupno
+    void run(unsigned int threadCount = 0);
+
+private:
+    struct Job {
+        std::string name;
+        std::function<void()> work;
+        std::function<void()> upload;
+        double workSeconds = 0.0;
+    };
+    std::vector<std::unique_ptr<Job>> jobs;
+    unsigned int parseThreadCount = 0;  // niti za parseOBJBuffer po .obj poslu, postavlja run()
+};
@@ -0,0 +1,5 @@
+#pragma once
+
+// Merenja performansi učitavanja, bez otvaranja prozora.
+// Pokretanje: Kostur.exe --bench [--bench-tris N]
+int runBenchmarks(int argc, char** argv);
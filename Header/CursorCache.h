@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// Kursori u više veličina, keširani na disku:
+// pri prvom pokretanju se slika dekodira jednom i smanjuje area filterom (ImageOps.h) na sve veličine iz
+// CURSOR_SIZES, a rezultat se upisuje u <slika>.cursors. Sledeća pokretanja samo čitaju traženu veličinu iz keša.
+// Keš je vezan za hash slike i verziju formata, kao .meshcache.
+const int CURSOR_SIZES[] = { 32, 48, 64, 96 };
+const int CURSOR_SIZE_COUNT = sizeof(CURSOR_SIZES) / sizeof(CURSOR_SIZES[0]);
+
+// Povećati pri svakoj promeni formata ili filtera
+const uint32_t CURSOR_CACHE_VERSION = 2;
+
+// RGBA8, redovi odozgo nadole (kako GLFW očekuje)
+struct CursorImage {
+    int size = 0;
+    std::vector<unsigned char> pixels;
+};
+
+// Veličina iz CURSOR_SIZES za dati content scale monitora (32 px pri 1.0; bira se najbliža veća)
+int cursorSizeForScale(float contentScale);
+
+std::string cursorCachePath(const char* imagePath);
+
+// Slika kursora tražene veličine iz keša; ako keš ne postoji ili je zastareo, pravi ga (bez GL/GLFW poziva)
+bool loadCursorImage(const char* imagePath, int size, CursorImage& image);
+
+// Hotspot je u centru slike
+GLFWcursor* createCursor(const CursorImage& image);
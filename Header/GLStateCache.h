@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+
+// Tanak sloj iznad GL poziva za stanje: pamti poslednju postavljenu vrednost i preskače poziv kad se ona ne menja
+// (isto što ShaderProgram radi za uniforme). Broji stvarne promene i preskočene pozive po frejmu, da se vidi koliko
+// se štedi. Sve promene stanja u petlji crtanja moraju da idu kroz keš; kod koji GL poziva direktno (učitavanje,
+// TextureStreamer) posle sebe ostavlja stanje nepoznatim, pa se tada zove invalidate / invalidateBindings.
+//
+//   GLStateCache state;
+//   state.setCapability(CAPABILITY_CULL_FACE, true);  // glEnable samo ako već nije uključeno
+//   state.bindVertexArray(vao);                       // glBindVertexArray samo ako je vezan drugi VAO
+
+enum GLCapability {
+    CAPABILITY_DEPTH_TEST,
+    CAPABILITY_CULL_FACE,
+    CAPABILITY_BLEND,
+    CAPABILITY_POLYGON_OFFSET_FILL,
+    CAPABILITY_COUNT
+};
+
+// Broj teksturnih jedinica koje keš prati; bindTexture2D za višu jedinicu ide direktno u GL
+const unsigned int STATE_CACHE_TEXTURE_UNITS = 8;
+
+class GLStateCache {
+public:
+    // Na početku je sve stanje nepoznato
+    GLStateCache();
+
+    void setCapability(GLCapability capability, bool enabled);
+    void blendFunc(unsigned int source, unsigned int destination);
+    void polygonOffset(float factor, float units);
+    void cullFace(unsigned int mode);
+    void useProgram(unsigned int program);
+    void bindVertexArray(unsigned int vao);
+    // glActiveTexture + glBindTexture(GL_TEXTURE_2D); aktivna jedinica se takođe pamti
+    void bindTexture2D(unsigned int unit, unsigned int texture);
+
+    // Sve stanje postaje nepoznato (sledeći poziv svakako ide u GL)
+    void invalidate();
+    // Samo veze objekata (VAO, teksture, aktivna jedinica) – njih menjaju i loader-i i TextureStreamer
+    void invalidateBindings();
+
+    // Početak frejma: nuluje brojače frejma i zaboravlja veze objekata (vidi invalidateBindings)
+    void beginFrame();
+
+    // Stvarni GL pozivi / preskočeni pozivi u tekućem frejmu i od pokretanja
+    size_t frameTransitions() const { return frameChanged; }
+    size_t frameSkipped() const { return frameRedundant; }
+    size_t totalTransitions() const { return totalChanged + frameChanged; }
+    size_t totalSkipped() const { return totalRedundant + frameRedundant; }
+    size_t frameCount() const { return frames + (frameChanged + frameRedundant > 0 ? 1 : 0); }
+
+private:
+    // true ako poziv treba poslati; broji promenu ili preskočen poziv
+    bool transition(bool differs);
+
+    signed char capabilities[CAPABILITY_COUNT];  // -1 nepoznato, 0 isključeno, 1 uključeno
+    bool blendKnown = false, offsetKnown = false, cullModeKnown = false, programKnown = false, vaoKnown = false;
+    bool activeUnitKnown = false;
+    bool textureKnown[STATE_CACHE_TEXTURE_UNITS] = {};
+    unsigned int blendSource = 0, blendDestination = 0;
+    float offsetFactor = 0.0f, offsetUnits = 0.0f;
+    unsigned int cullMode = 0;
+    unsigned int program = 0, vao = 0;
+    unsigned int activeUnit = 0;
+    unsigned int textures[STATE_CACHE_TEXTURE_UNITS] = {};
+
+    size_t frameChanged = 0, frameRedundant = 0;
+    size_t totalChanged = 0, totalRedundant = 0;
+    size_t frames = 0;
+};
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Model.h"
+
+// Učitavanje binarnog glTF 2.0 (.glb) fajla bez prepakovanja vertex-a:
+// fajl se mapira u memoriju, ceo BIN blok ide u jedan GL bafer, a atributi i indeksi svakog primitiva
+// se samo opisuju offset-ima u tom baferu (glVertexAttribPointer / glDrawElements).
+// Pozicije i UV idu na iste lokacije kao PackedVertex (0 i 2), a normale kao vec3 na lokaciju 1; pri crtanju
+// u basic.vert treba uFloatNormals = true i podrazumevana VertexQuantization (pozicije nisu kvantizovane) –
+// Main.cpp to radi preko DrawItem::floatNormals (Kostur.exe --glb crta automat iz .glb fajla).
+
+// Jedan atribut primitiva – tačno kako ga opisuje accessor (offset je od početka BIN bloka)
+struct GLTFAttribute {
+    bool present = false;
+    int components = 0;           // 1..4
+    unsigned int componentType = 0;  // GL_FLOAT, GL_UNSIGNED_SHORT...
+    bool normalized = false;
+    unsigned int stride = 0;      // 0 = gusto pakovano
+    size_t offset = 0;
+};
+
+struct GLTFPrimitive {
+    GLTFAttribute position;
+    GLTFAttribute normal;
+    GLTFAttribute texCoord;
+    unsigned int mode = 4;         // GL_TRIANGLES (glTF mode je isti kao GL enum)
+    unsigned int vertexCount = 0;
+    unsigned int indexCount = 0;   // 0 = crta se bez indeksa (glDrawArrays)
+    unsigned int indexType = 0;    // GL_UNSIGNED_BYTE/SHORT/INT
+    unsigned int indexSize = 0;    // bajtova po indeksu (1, 2 ili 4)
+    size_t indexOffset = 0;        // offset indeksa u BIN bloku (za glDrawElements)
+    int material = -1;             // indeks u GLTFModel::materials, -1 = podrazumevani
+    unsigned int VAO = 0;
+};
+
+struct GLTFMesh {
+    std::string name;
+    std::vector<GLTFPrimitive> primitives;
+};
+
+// Čvor hijerarhije; world = world roditelja * local, izračunato pri učitavanju
+struct GLTFNode {
+    std::string name;
+    glm::mat4 local = glm::mat4(1.0f);
+    glm::mat4 world = glm::mat4(1.0f);
+    int parent = -1;
+    int mesh = -1;
+    std::vector<int> children;
+};
+
+struct GLTFModel {
+    std::vector<GLTFNode> nodes;
+    std::vector<int> roots;                  // čvorovi scene (glTF "scene")
+    std::vector<GLTFMesh> meshes;
+    std::vector<Material> materials;         // glTF PBR materijali svedeni na Material (vidi GLTFLoader.cpp)
+    std::vector<std::string> materialNames;
+    unsigned int materialBase = 0;           // indeks materijala 0 unutar MaterialUniformBuffer (vidi UniformBlocks.h)
+    size_t binOffset = 0, binLength = 0;     // BIN blok unutar .glb fajla
+    unsigned int buffer = 0;                 // GL bafer sa celim BIN blokom (vertex-i i indeksi)
+    unsigned int triangleCount = 0;          // zbir po čvorovima (instancirane mreže se broje više puta)
+};
+
+// Parsiranje .glb bafera (JSON + provera accessor-a, hijerarhija, materijali) bez GL poziva
+bool parseGLB(const char* data, size_t size, GLTFModel& model);
+
+// Pravi GL bafer od BIN bloka i VAO za svaki primitiv; data je isti bafer koji je prošao kroz parseGLB
+void uploadGLTFModel(GLTFModel& model, const char* data);
+
+// Mapira fajl, parsira ga i šalje na GPU
+bool loadGLB(const char* filePath, GLTFModel& model);
+
+void deleteGLTFModel(GLTFModel& model);
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// FNV-1a 64-bitni hash (za ključeve keševa i deduplikaciju sadržaja)
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+// hashBytes nad celim sadržajem fajla na disku; 0 ako fajl ne postoji (ili je putanja prazna)
+uint64_t hashFile(const std::string& path);
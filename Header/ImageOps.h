@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+
+// Operacije nad slikama u RAM-u (bez GL poziva). Na x86/x64 jezgra koriste SSE2 (osnova za x64), a AVX2 kad je
+// uključen pri prevođenju (/arch:AVX2, -mavx2); na ostalim platformama isti rezultat daje skalarna verzija.
+// Sve verzije daju bajt-identičan izlaz (proverava --bench).
+
+// Okreće redove slike u mestu (prvi <-> poslednji); channels = bajtova po pikselu
+void flipRowsVertical(unsigned char* pixels, int width, int height, int channels);
+
+// 1-4 kanala u RGBA8 kao što ih vidi glTexImage2D sa GL_RED/GL_RG/GL_RGB (nedostajući kanali 0, alfa 255)
+void expandToRGBA(const unsigned char* src, int channels, size_t pixelCount, unsigned char* dst);
+
+// rgb = rgb * a / 255 (tačno zaokruženo), u mestu
+void premultiplyAlphaRGBA(unsigned char* pixels, size_t pixelCount);
+
+// sRGB8 <-> linearni float (alfa je uvek linearna, 0..1)
+void srgbToLinearRGBA(const unsigned char* src, size_t pixelCount, float* dst);
+void linearToSrgbRGBA(const float* src, size_t pixelCount, unsigned char* dst);
+
+// Sledeći mip nivo (max(1, w/2) x max(1, h/2)): prosek 2x2 piksela, kod dimenzije 1 se red/kolona ponavlja.
+// RGBA8 verzija usrednjava kodirane vrednosti; Linear verzija radi nad linearnim float-ovima (gamma-ispravno).
+void downsample2xRGBA(const unsigned char* src, int width, int height, unsigned char* dst);
+void downsample2xLinearRGBA(const float* src, int width, int height, float* dst);
+
+// Promena veličine RGBA8 slike area filterom: svaki izlazni piksel je prosek svih ulaznih piksela koje pokriva,
+// sa težinom srazmernom pokrivenoj površini (tačno za bilo koji odnos veličina, ne samo 2:1).
+// Filtrira se u premultiplied alpha obliku, da providni pikseli ne tamne ivice.
+void resizeAreaRGBA(const unsigned char* src, int srcWidth, int srcHeight, unsigned char* dst, int dstWidth, int dstHeight);
+
+// Isključuje SIMD putanje (samo za merenja i proveru – nije bezbedno menjati dok druge niti obrađuju slike)
+void setImageOpsSimdEnabled(bool enabled);
+// "AVX2", "SSE2" ili "skalarno" – najbolja putanja u ovom prevodu
+const char* imageOpsSimdLevel();
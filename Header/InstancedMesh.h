@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct OBJModel;
+
+// Instancirano crtanje OBJ modela (igračke): svaka instanca ima svoju matricu i boju u per-instance baferu,
+// pa se ceo skup crta jednim glDrawElementsInstanced po materijalu, bez obzira na broj instanci.
+// Matrice smeju da imaju samo rotaciju, translaciju i uniformno skaliranje – basic.vert (INSTANCED) koristi
+// mat3(inModel) kao matricu normala (vidi Transform.h).
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 tint;  // množi boju materijala (rgb); a se ne koristi
+};
+static_assert(sizeof(InstanceData) == 80, "InstanceData mora da prati atribute 4–8 u basic.vert");
+
+const unsigned int INSTANCE_MODEL_ATTRIBUTE = 4;  // mat4: lokacije 4–7
+const unsigned int INSTANCE_TINT_ATTRIBUTE = 8;
+
+class InstancedMesh {
+public:
+    // Pravi poseban VAO nad VBO/EBO modela (model.VAO ostaje za pojedinačno crtanje) i bafer instanci.
+    // Model mora da živi dok i InstancedMesh.
+    void create(const OBJModel& model);
+
+    void clear() { instances.clear(); }
+    void add(const glm::mat4& model, const glm::vec4& tint = glm::vec4(1.0f));
+    // Šalje instance na GPU (ceo bafer se zamenjuje) – jednom po frejmu, posle svih add
+    void upload();
+
+    const OBJModel* mesh() const { return model; }
+    unsigned int vao() const { return vertexArray; }
+    size_t instanceCount() const { return instances.size(); }
+
+    void destroy();
+
+private:
+    const OBJModel* model = nullptr;
+    unsigned int vertexArray = 0, instanceBuffer = 0;
+    size_t capacity = 0;  // instanci u baferu na GPU
+    std::vector<InstanceData> instances;
+};
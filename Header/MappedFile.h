@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+
+// Fajl mapiran u memoriju samo za čitanje (Windows: CreateFileMapping, ostalo: mmap).
+// Sadržaj ostaje dostupan preko data()/size() dok se objekat ne zatvori ili uništi.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Savet sistemu da pročitane stranice [offset, offset + count) više nisu potrebne (izbacuju se iz
+    // radnog skupa procesa); sadržaj ostaje čitljiv – ponovni pristup ga samo opet učitava sa diska
+    void releasePages(size_t offset, size_t count) const;
+
+private:
+    void moveFrom(MappedFile& other);
+
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+// Upisuje header pa payload u privremeni fajl (path + ".tmp") i tek ga onda preimenuje u path,
+// da prekinut upis ne ostavi polovičan fajl. Vraća false ako upis ili preimenovanje ne uspe.
+bool writeFileAtomically(const char* path, const void* header, size_t headerSize, const void* payload, size_t payloadSize);
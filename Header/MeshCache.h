@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Model.h"
+
+// Binarni keš za OBJModel posle deduplikacije vertex-a:
+// kompaktni vertex-i (PackedVertex), indeksi, opsezi materijala i tabela materijala.
+// Keš je vezan za hash .obj i .mtl fajla i verziju formata – ako se bilo šta promeni, keš je zastareo.
+
+// Povećati pri svakoj promeni rasporeda podataka u kešu
+const uint32_t MESH_CACHE_VERSION = 4;
+
+// Zastavice obrade sačuvane u kešu (keš važi samo ako se poklapaju sa traženim)
+const uint32_t MESH_CACHE_OPTIMIZED = 1;  // indeksi i vertex-i prošli kroz MeshOptimizer
+
+// Putanja keša za dati .obj fajl (pored izvornog fajla)
+std::string meshCachePath(const char* objPath);
+
+// Čita model iz keša ako postoji i odgovara hash-u .obj fajla, bez GL poziva: zaglavlje, materijali i
+// opsezi idu u model, a upload.cache ostaje otvoren i pokazuje na vertex-e i indekse u mapiranom fajlu.
+// Vraća false ako keš ne postoji ili je zastareo.
+bool readMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, OBJModel& model, OBJUploadData& upload);
+
+// readMeshCache + uploadPreparedOBJ: vertex-i i indeksi se šalju na GPU direktno iz mapiranog fajla
+bool loadMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, OBJModel& model);
+
+// Upisuje keš za model (vertices/indices/ranges moraju biti popunjeni)
+bool writeMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, const std::string& mtlPath, const OBJModel& model);
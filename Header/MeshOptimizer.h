@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Optimizacija indeksnog bafera posle deduplikacije vertex-a:
+// redosled trouglova za keš vertex-a (Forsyth), grubo sortiranje klastera protiv overdraw-a
+// i preuređivanje vertex-a po redosledu korišćenja (lokalnost pri čitanju).
+
+// Statistika keša vertex-a posle transformacije, simulirana kao FIFO keš date veličine
+struct VertexCacheStats {
+    float acmr;  // prosečan broj promašaja po trouglu (idealno 0.5, najgore 3)
+    float atvr;  // promašaji / broj korišćenih vertex-a (idealno 1)
+};
+
+const unsigned int VERTEX_CACHE_SIM_SIZE = 16;
+
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize = VERTEX_CACHE_SIM_SIZE);
+
+// Preuređuje trouglove (unutar datog opsega indeksa) radi ponovne upotrebe vertex-a iz keša
+void optimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+// Deli opseg na klastere na mestima gde keš kreće "od nule" i sortira ih tako da
+// spoljašnji delovi modela budu nacrtani pre unutrašnjih (manje overdraw-a)
+void optimizeOverdraw(unsigned int* indices, size_t indexCount, const float* positions, size_t positionStride, size_t vertexCount);
+
+// Numeriše vertex-e po prvom korišćenju i prepisuje indekse; vraća remap stari -> novi
+// (vertex-i koji se ne koriste dobijaju mesta na kraju)
+std::vector<unsigned int> optimizeVertexFetch(unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+// Primena remap-a iz optimizeVertexFetch na vertex bafer
+template <typename Vertex>
+void remapVertexBuffer(std::vector<Vertex>& vertices, const std::vector<unsigned int>& remap) {
+    std::vector<Vertex> reordered(vertices.size());
+    for (size_t v = 0; v < remap.size(); ++v)
+        reordered[remap[v]] = vertices[v];
+    vertices.swap(reordered);
+}
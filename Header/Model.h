@@ -0,0 +1,90 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <glm/glm.hpp>
+#include "VertexFormat.h"
+#include "MappedFile.h"
+
+// Struktura za materijal
+struct Material {
+    glm::vec3 Kd;  // Diffuse color
+    glm::vec3 Ka;  // Ambient color
+    glm::vec3 Ks;  // Specular color
+    float Ns;      // Shininess
+    float d;       // Dissolve (alpha)
+};
+
+// Uzastopni opseg indeksa jednog materijala; trouglovi su pri učitavanju sortirani po materijalu,
+// pa svaki materijal ima tačno jedan opseg
+struct MaterialRange {
+    unsigned int first;         // prvi indeks u EBO
+    unsigned int count;         // broj indeksa
+    unsigned int materialSlot;  // indeks u OBJModel::materials / materialNames
+};
+
+// Struktura za čuvanje podataka o .obj modelu
+struct OBJModel {
+    std::vector<PackedVertex> vertices;  // 16 bajtova po vertex-u (vidi VertexFormat.h)
+    std::vector<unsigned int> indices;   // na CPU uvek 32-bitni; u EBO idu kao indexSize bajtova
+    VertexQuantization quantization;     // dekvantizacija pozicija (uPosScale/uPosBias)
+    std::vector<Material> materials;        // Materijali po slotu (redosled imena iz .mtl, kao u std::map)
+    std::vector<std::string> materialNames; // Ime materijala za svaki slot
+    std::vector<MaterialRange> ranges;      // Po jedan opseg za svaki korišćeni materijal, rastuće po slotu
+    unsigned int VAO = 0, VBO = 0, EBO = 0;
+    unsigned int indexCount = 0;
+    unsigned int vertexCount = 0;  // vertices/indices ostaju prazni kad se model učita iz keša (idu direktno na GPU)
+    unsigned int indexSize = 4;    // 2 kad vertexCount <= MAX_SHORT_INDEX_VERTICES
+    unsigned int indexType = 0;    // GL_UNSIGNED_SHORT ili GL_UNSIGNED_INT, postavlja uploadOBJModel
+    unsigned int materialBase = 0; // indeks materijala u slotu 0 unutar MaterialUniformBuffer (vidi UniformBlocks.h)
+};
+
+// Podaci za GPU pripremljeni na bilo kojoj niti; GL objekte pravi uploadPreparedOBJ na niti sa kontekstom.
+// Kad je model iz keša, vertex-i i indeksi se čitaju direktno iz mapiranog keš fajla; inače iz model.vertices/indices.
+struct OBJUploadData {
+    MappedFile cache;
+    const PackedVertex* vertexData = nullptr;
+    const void* indexData = nullptr;
+};
+
+// Funkcija za učitavanje .mtl fajla
+std::map<std::string, Material> loadMTL(const char* mtlPath);
+
+// Parsiranje .obj teksta iz bafera u interleaved vertex-e i indekse, bez GL poziva.
+// objDir je direktorijum .obj fajla (za mtllib), a mtlPath dobija putanju učitanog .mtl fajla.
+// threadCount = 0 koristi sva jezgra; rezultat je isti bez obzira na broj niti.
+bool parseOBJBuffer(const char* data, size_t size, const std::string& objDir, OBJModel& model, std::string& mtlPath, unsigned int threadCount = 0);
+
+// Streaming parsiranje za ogromne fajlove: jedna nit, uglovi lica se deduplikuju čim se pročitaju,
+// pa se ne prave nizovi pos/tex/norm indeksa po uglu. Vršna memorija je približno izlaz + v/vt/vn nizovi
+// + hash tabela. Ako je source zadat, već pročitane stranice mapiranog fajla se usput vraćaju sistemu.
+// Rezultat je isti kao iz parseOBJBuffer: trouglovi grupisani po slotu, unutar slota redosled iz fajla
+// (i u slotu 0, gde završavaju i nepoznati materijali).
+bool parseOBJStreaming(const char* data, size_t size, const std::string& objDir, OBJModel& model, std::string& mtlPath, const MappedFile* source = nullptr);
+
+// Način parsiranja u loadOBJ; Auto bira Streaming za fajlove veće od OBJ_STREAMING_THRESHOLD
+enum class ObjParseMode { Auto, Parallel, Streaming };
+const size_t OBJ_STREAMING_THRESHOLD = 256ull << 20;
+
+// Preuređuje trouglove unutar opsega svakog materijala za keš vertex-a i overdraw, pa vertex-e po redosledu
+// korišćenja (vidi MeshOptimizer.h); ispisuje ACMR/ATVR pre i posle
+void optimizeOBJModel(OBJModel& model, const char* name);
+
+// Deo učitavanja .obj fajla bez GL poziva (sme na radnoj niti): prvo pokušava binarni keš (vidi MeshCache.h),
+// pa tekstualni .obj. optimize = true propušta model kroz optimizeOBJModel (rezultat se čuva u kešu); u streaming
+// režimu optimizacija se preskače jer bi zahtevala dodatne kopije indeksa i pozicija. threadCount ide u parseOBJBuffer
+// (0 = sva jezgra); pozivaoci koji već rade na više niti prosleđuju svoj deo jezgara. Vraća false ako model nema podataka.
+bool prepareOBJ(const char* filePath, OBJModel& model, OBJUploadData& upload, bool optimize = true, ObjParseMode mode = ObjParseMode::Auto,
+                unsigned int threadCount = 0);
+
+// Pravi VAO/VBO/EBO od rezultata prepareOBJ (mora na niti sa GL kontekstom); oslobađa upload podatke
+void uploadPreparedOBJ(OBJModel& model, OBJUploadData& upload);
+
+// Funkcija za učitavanje .obj fajla – prepareOBJ + uploadPreparedOBJ na pozivajućoj niti
+OBJModel loadOBJ(const char* filePath, bool optimize = true, ObjParseMode mode = ObjParseMode::Auto);
+
+// Pravi VAO/VBO/EBO za model; indexData je već u formatu model.indexSize
+void uploadOBJModel(OBJModel& model, const PackedVertex* vertexData, const void* indexData);
+
+// Indeksi modela u formatu za EBO (16-bitni se prave u shortIndices, koji mora da živi do upload-a)
+const void* objIndexData(const OBJModel& model, std::vector<uint16_t>& shortIndices);
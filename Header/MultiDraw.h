@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+struct OBJModel;
+struct MaterialRange;
+
+// Statičan skup opsega jednog modela (automat) koji se crta jednim glMultiDrawElementsIndirect iz bafera komandi
+// napravljenog pri učitavanju. Materijal svakog opsega dolazi iz per-draw atributa (lokacija 9, divisor 1):
+// komanda i ima baseInstance = i, pa atribut za nju čita i-ti indeks materijala – isto što i gl_DrawID, ali radi
+// već sa GL 4.2 base instance. Sejder varijanta sa MULTI_DRAW čita materijal iz atributa umesto iz uMaterialIndex.
+// Traži GL 4.3 ili ARB_multi_draw_indirect + ARB_base_instance; bez toga create vraća false i opsezi se crtaju
+// pojedinačno (glMultiDrawElements bez draw ID-a ne bi mogao da menja materijal između opsega).
+
+const unsigned int MULTI_DRAW_MATERIAL_ATTRIBUTE = 9;
+
+// Raspored koji zahteva glMultiDrawElementsIndirect
+struct DrawElementsIndirectCommand {
+    uint32_t count;
+    uint32_t instanceCount;
+    uint32_t firstIndex;
+    int32_t baseVertex;
+    uint32_t baseInstance;
+};
+
+bool multiDrawIndirectSupported();
+
+class MultiDrawBatch {
+public:
+    // Pravi VAO nad VBO/EBO modela, bafer komandi i bafer materijala; false ako MDI nije podržan ili nema opsega.
+    // Model mora da živi dok i batch.
+    bool create(const OBJModel& model, const std::vector<MaterialRange>& ranges);
+    bool valid() const { return commandCount > 0; }
+
+    unsigned int vao() const { return vertexArray; }
+    unsigned int drawCount() const { return commandCount; }
+    // Jedan poziv za sve opsege (VAO mora biti vezan)
+    void draw() const;
+    void destroy();
+
+private:
+    unsigned int vertexArray = 0, commandBuffer = 0, materialBuffer = 0;
+    unsigned int indexType = 0;
+    unsigned int commandCount = 0;
+};
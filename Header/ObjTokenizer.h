@@ -0,0 +1,93 @@
+#pragma once
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+// Tokenizer za .obj/.mtl tekst koji radi direktno nad baferom (mapiran ili ceo učitan fajl).
+// Ne pravi nikakve alokacije: tokeni su std::string_view u originalni bafer,
+// a brojevi se parsiraju sa std::from_chars.
+struct ObjTokenizer {
+    const char* cur;  // trenutna pozicija u liniji
+    const char* end;  // kraj trenutne linije (bez '\n')
+
+    bool atEnd() const { return cur >= end; }
+
+    void skipSpaces() {
+        while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r'))
+            ++cur;
+    }
+
+    // Sledeća reč do razmaka ili kraja linije (prazna ako je linija gotova)
+    std::string_view nextToken() {
+        skipSpaces();
+        const char* start = cur;
+        while (cur < end && *cur != ' ' && *cur != '\t' && *cur != '\r')
+            ++cur;
+        return std::string_view(start, (size_t)(cur - start));
+    }
+
+    // Čita float; ako ga nema, vrednost ostaje nepromenjena i vraća false
+    bool parseFloat(float& out) {
+        skipSpaces();
+        const char* start = (cur < end && *cur == '+') ? cur + 1 : cur;
+        std::from_chars_result result = std::from_chars(start, end, out);
+        if (result.ec != std::errc()) {
+            // Preskačemo nečitljiv token da ne bi blokirao ostatak linije
+            nextToken();
+            return false;
+        }
+        cur = result.ptr;
+        return true;
+    }
+
+    // Čita jedan ugao lica u formatu v, v/vt, v//vn ili v/vt/vn.
+    // Indeksi su kao u fajlu (od 1, negativni su relativni); 0 znači da komponenta ne postoji.
+    bool parseFaceCorner(long& v, long& vt, long& vn) {
+        skipSpaces();
+        v = vt = vn = 0;
+        if (cur >= end)
+            return false;
+        std::from_chars_result result = std::from_chars(cur, end, v);
+        if (result.ec != std::errc()) {
+            nextToken();
+            return false;
+        }
+        cur = result.ptr;
+        if (cur < end && *cur == '/') {
+            ++cur;
+            if (cur < end && *cur != '/') {
+                result = std::from_chars(cur, end, vt);
+                if (result.ec == std::errc()) cur = result.ptr;
+            }
+            if (cur < end && *cur == '/') {
+                ++cur;
+                result = std::from_chars(cur, end, vn);
+                if (result.ec == std::errc()) cur = result.ptr;
+            }
+        }
+        // Ostatak neispravnog tokena (npr. "1/2/3abc") se preskače
+        while (cur < end && *cur != ' ' && *cur != '\t' && *cur != '\r')
+            ++cur;
+        return true;
+    }
+};
+
+// Iteracija kroz linije bafera: vraća tokenizer za sledeću liniju i pomera pos iza nje
+inline bool nextObjLine(const char*& pos, const char* bufferEnd, ObjTokenizer& line) {
+    if (pos >= bufferEnd)
+        return false;
+    const char* newline = (const char*)std::memchr(pos, '\n', (size_t)(bufferEnd - pos));
+    const char* lineEnd = newline ? newline : bufferEnd;
+    line.cur = pos;
+    line.end = lineEnd;
+    pos = newline ? newline + 1 : bufferEnd;
+    return true;
+}
+
+// Pretvara indeks iz fajla (od 1 ili negativan relativni) u indeks od 0.
+// Nepostojeći ili neispravan indeks postaje veliki broj i tretira se kao "van opsega".
+inline unsigned int resolveObjIndex(long index, size_t count) {
+    if (index > 0) return (unsigned int)(index - 1);
+    if (index < 0) return (unsigned int)((long)count + index);
+    return 0xFFFFFFFFu;
+}
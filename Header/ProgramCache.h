@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Keš linkovanih sejder programa: izlaz glGetProgramBinary se čuva na disku pored vertex sejdera, uz hash
+// izvornog koda oba sejdera i drajvera (GL_VENDOR, GL_RENDERER, GL_VERSION). Pri sledećem pokretanju program
+// se pravi sa glProgramBinary, bez prevođenja; iz izvora se prevodi samo ako keša nema, ako je zastareo ili
+// ako ga drajver odbije (binarni format sme da se promeni i bez promene verzije drajvera).
+// Radi na GL 4.1+ ili sa ARB_get_program_binary; bez toga je isto što i createShader.
+
+// Povećati pri svakoj promeni rasporeda keš fajla
+const uint32_t PROGRAM_CACHE_VERSION = 1;
+
+// Putanja keša za par sejdera: <vertex sejder>.<ime fragment sejdera>.programcache; permutacija sa definicijama
+// (vidi ShaderVariants.h) dobija i hash definicija: <vertex sejder>.<ime fragment sejdera>.<hash>.programcache
+std::string programCachePath(const char* vsPath, const char* fsPath, const char* defines = nullptr);
+
+// Program iz keša, a ako ne može – prevodi ga iz izvora (kao createShader) i upisuje keš. 0 ako linkovanje ne uspe.
+// defines se ubacuju u oba sejdera posle #version (vidi compileShader).
+unsigned int loadShaderProgram(const char* vsPath, const char* fsPath, const char* defines = nullptr);
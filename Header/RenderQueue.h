@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "VertexFormat.h"
+
+class MultiDrawBatch;
+
+// Red crtanja jednog frejma: objekti predaju stavke crtanja sa 64-bitnim ključem, red ih jednom sortira (radix)
+// i izvršavaju se redom ključeva, pa se program, VAO, raster stanje i materijal menjaju samo kad se razlikuju
+// od prethodne stavke. Redosled crtanja tako određuje ključ, a ne redosled predaje.
+//
+// Ključ, od najvišeg bita:
+//   neprozirni prolazi: prolaz (4) | program (4) | raster stanje (4) | mesh (8) | materijal (12) | dubina (32)
+//   providni prolaz:    prolaz (4) | obrnuta dubina (32) | program (4) | raster stanje (4) | mesh (8) | materijal (12)
+// Neprozirno se crta od bližeg ka daljem (rani test dubine), providno od daljeg ka bližem (ispravno mešanje).
+// Mesh u ključu je samo grupisanje (donjih 8 bita VAO-a); sudar dva VAO-a ne kvari crtanje, samo grupisanje.
+
+enum RenderPass {
+    RENDER_PASS_OPAQUE = 0,
+    RENDER_PASS_OPAQUE_OFFSET,   // posle neprozirnih, sa glPolygonOffset (kandža preko igračke koju nosi)
+    RENDER_PASS_TRANSPARENT,
+    RENDER_PASS_OVERLAY,         // 2D preko scene, bez testa dubine
+    RENDER_PASS_COUNT
+};
+
+// Raster stanje stavke (bitovi u ključu)
+const uint32_t RENDER_STATE_DOUBLE_SIDED = 1;  // bez odstranjivanja naličja
+
+// Transformacija jednog objekta u frejmu; matrica normala se računa jednom po objektu, ne po stavci
+struct DrawTransform {
+    glm::mat4 model;
+    glm::mat3 normal;
+    float depth;  // udaljenost od kamere (za ključ)
+};
+
+struct DrawItem {
+    uint8_t pass = RENDER_PASS_OPAQUE;
+    uint8_t program = 0;       // ShaderVariant
+    uint8_t state = 0;         // RENDER_STATE_*
+    uint32_t transform = 0;    // indeks iz RenderQueue::addTransform
+    unsigned int vao = 0;
+    unsigned int indexType = 0;
+    unsigned int indexSize = 0;
+    unsigned int first = 0, count = 0;  // opseg indeksa u EBO
+    const VertexQuantization* quantization = nullptr;
+    int material = 0;          // indeks u MaterialBlock
+    unsigned int texture = 0;  // 0 = bez teksture
+    unsigned int instanceCount = 0;  // > 0: glDrawElementsInstanced (vao sa per-instance atributima, vidi InstancedMesh.h)
+    bool floatNormals = false;       // normala iz vec3 atributa na lokaciji 1 umesto oktaedarske (GLB, vidi GLTFLoader.h)
+    // != nullptr: ceo skup opsega jednim glMultiDrawElementsIndirect (vao = multiDraw->vao(), materijal po komandi,
+    // first/count/material se ne koriste; vidi MultiDraw.h)
+    const MultiDrawBatch* multiDraw = nullptr;
+};
+
+uint64_t renderSortKey(const DrawItem& item, float depth);
+
+class RenderQueue {
+public:
+    // Prazni red za novi frejm; kamera služi za dubinu u ključevima
+    void begin(const glm::vec3& cameraPos);
+
+    uint32_t addTransform(const glm::mat4& model);
+    uint32_t addTransform(const glm::mat4& model, const glm::mat3& normal);
+    const DrawTransform& transform(uint32_t index) const { return transforms[index]; }
+
+    void submit(const DrawItem& item);
+    // Radix sort po ključu (stabilan; iste ključeve ostavlja u redosledu predaje)
+    void sort();
+
+    size_t size() const { return items.size(); }
+    // i-ta stavka po redosledu ključeva (posle sort)
+    const DrawItem& sorted(size_t i) const { return items[order[i].item]; }
+
+private:
+    struct SortEntry {
+        uint64_t key;
+        uint32_t item;
+    };
+
+    glm::vec3 cameraPos = glm::vec3(0.0f);
+    std::vector<DrawTransform> transforms;
+    std::vector<DrawItem> items;
+    std::vector<SortEntry> order, scratch;  // ostaju alocirani između frejmova
+};
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+#include "UniformHandle.h"
+
+// Sejder program sa reflektovanim uniformama: posle linkovanja se aktivne uniforme jednom nabroje
+// (glGetActiveUniform) i dobiju handle-ove, pa u petlji crtanja nema glGetUniformLocation ni poređenja stringova.
+// Setteri pamte poslednju poslatu vrednost i preskaču glUniform* kad se ona ne menja.
+// Setteri rade nad trenutno aktivnim programom (use()), kao i glUniform*.
+//
+//   ShaderProgram program(loadShaderProgram("basic.vert", "basic.frag"));
+//   UniformHandle colorUniform = program.uniform("uColor");   // jednom, pri pokretanju
+//   ...
+//   program.use();
+//   program.set(colorUniform, glm::vec4(1.0f));               // u petlji
+class ShaderProgram {
+public:
+    ShaderProgram() = default;
+    // Preuzima GL program (0 = neuspelo linkovanje, sve uniforme su tada nevažeće)
+    explicit ShaderProgram(unsigned int program);
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+    ShaderProgram(ShaderProgram&& other) noexcept;
+    ShaderProgram& operator=(ShaderProgram&& other) noexcept;
+
+    unsigned int id() const { return program; }
+    void use() const;
+    // Briše GL program (mora pre uništavanja GL konteksta)
+    void destroy();
+
+    // Handle po imenu (za nizove ime bez "[0]"); INVALID_UNIFORM_HANDLE ako nije aktivna.
+    // Uniforme iz uniform blokova nemaju handle – njih puni bafer vezan za binding tačku bloka.
+    UniformHandle uniform(const char* name) const;
+
+    // Vezuje uniform blok za binding tačku (glUniformBlockBinding); false ako blok nije aktivan
+    // (permutacija ga ne koristi ili ga je kompajler izbacio – kao INVALID_UNIFORM_HANDLE, bez greške).
+    // Veza je deo stanja programa, pa se postavlja posle svakog linkovanja / glProgramBinary.
+    bool bindUniformBlock(const char* blockName, unsigned int binding) const;
+
+    // Tip mora da odgovara deklaraciji u sejderu (bool i sampler se postavljaju kao int)
+    void set(UniformHandle handle, int value);
+    void set(UniformHandle handle, float value);
+    void set(UniformHandle handle, const glm::vec2& value);
+    void set(UniformHandle handle, const glm::vec3& value);
+    void set(UniformHandle handle, const glm::vec4& value);
+    void set(UniformHandle handle, const glm::mat3& value);
+    void set(UniformHandle handle, const glm::mat4& value);
+
+    // Poslate / preskočene vrednosti od pokretanja (za proveru koliko se štedi)
+    size_t uploadCount() const { return uploads; }
+    size_t skippedCount() const { return skipped; }
+
+private:
+    struct Uniform {
+        std::string name;
+        int location = -1;
+        unsigned int type = 0;
+        unsigned int offset = 0;  // u values
+        unsigned int size = 0;    // bajtova (jedan element)
+        bool known = false;       // da li values sadrži vrednost koja je stvarno u programu
+        bool typeErrorReported = false;
+    };
+
+    // true ako treba poslati (vrednost se tada pamti); false za nevažeći handle, pogrešan tip ili istu vrednost
+    bool changed(UniformHandle handle, unsigned int type, const void* value, size_t size);
+    void reflect();
+
+    unsigned int program = 0;
+    std::vector<Uniform> uniforms;
+    std::vector<unsigned char> values;
+    size_t uploads = 0, skipped = 0;
+};
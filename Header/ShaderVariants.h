@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "ShaderProgram.h"
+
+// Permutacije jednog para sejdera: umesto grananja po fragmentu na uniformama (useTex, transparent, overlayMode),
+// svaka klasa crtanja dobija svoj program preveden iz istog izvora sa drugim #define-ovima (ubacuju se posle #version).
+// Varijanta se prevodi (ili učitava iz ProgramCache) tek kad je prvi put zatražena, pa se neiskorišćene nikad ne prevode.
+//
+// Definicije koje basic.vert/basic.frag razumeju:
+//   USE_TEXTURE – boja iz uTex umesto iz materijala
+//   TRANSPARENT – odbacuje skoro potpuno providne fragmente
+//   UNLIT       – 2D overlay: uM je cela transformacija do clip prostora, tekstura * boja, bez osvetljenja
+//   INSTANCED   – matrica i boja (tint) po instanci iz atributa 4–8 umesto uM (vidi InstancedMesh.h)
+//   MULTI_DRAW  – indeks materijala po komandi iz atributa 9 umesto uMaterialIndex (vidi MultiDraw.h)
+enum ShaderVariant {
+    SHADER_VARIANT_OPAQUE_LIT,
+    SHADER_VARIANT_OPAQUE_LIT_TEXTURED,
+    SHADER_VARIANT_TRANSPARENT_LIT,
+    SHADER_VARIANT_UNLIT_OVERLAY,
+    SHADER_VARIANT_OPAQUE_LIT_INSTANCED,
+    SHADER_VARIANT_OPAQUE_LIT_MULTIDRAW,
+    SHADER_VARIANT_TRANSPARENT_LIT_MULTIDRAW,
+    SHADER_VARIANT_COUNT
+};
+
+const char* shaderVariantName(ShaderVariant variant);
+// Linije "#define ...\n" za varijantu ("" za osnovnu)
+const char* shaderVariantDefines(ShaderVariant variant);
+
+class ShaderVariantCache {
+public:
+    ShaderVariantCache(const char* vsPath, const char* fsPath);
+    ShaderVariantCache(const ShaderVariantCache&) = delete;
+    ShaderVariantCache& operator=(const ShaderVariantCache&) = delete;
+
+    // Program varijante; prvi poziv je prevodi (neuspelo linkovanje daje program 0 i ne pokušava se ponovo)
+    ShaderProgram& get(ShaderVariant variant);
+    bool loaded(ShaderVariant variant) const { return isLoaded[variant]; }
+    size_t loadedCount() const;
+
+    // Zbir za sve varijante (vidi ShaderProgram::uploadCount)
+    size_t uploadCount() const;
+    size_t skippedCount() const;
+
+    // Briše sve prevedene programe (mora pre uništavanja GL konteksta)
+    void destroy();
+
+private:
+    std::string vsPath, fsPath;
+    ShaderProgram programs[SHADER_VARIANT_COUNT];
+    bool isLoaded[SHADER_VARIANT_COUNT] = {};
+};
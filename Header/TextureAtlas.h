@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+
+// Atlas za 2D sprajtove: slike se pri pokretanju pakuju (skyline, bottom-left) u jednu RGBA teksturu, pa ceo 2D
+// frejm crta sa jednim glBindTexture umesto po jednim za svaki sprajt.
+// Svaki sprajt ima gutter od `padding` piksela sa ponovljenim ivičnim pikselima, a mesta su poravnata na 4 piksela;
+// mip lanac se zato pravi samo do nivoa 2 (1/4), da se susedni sprajtovi ne mešaju ni na najmanjem nivou.
+// Redovi su okrenuti kao posle decodeTextureImage (v = 0 je dno slike), pa UV pravougaonici idu direktno u glTexCoord.
+
+struct AtlasOptions {
+    int padding = 4;          // gutter oko svakog sprajta (u pikselima)
+    int maxSpriteSize = 1024; // veće slike se area filterom smanjuju na ovu dužu stranicu
+    int maxAtlasSize = 4096;  // dodatno ograničeno sa GL_MAX_TEXTURE_SIZE pri upload-u
+};
+
+struct AtlasSprite {
+    std::string path;
+    int x = 0, y = 0, width = 0, height = 0;  // u pikselima atlasa, bez gutter-a
+    float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+};
+
+// Atlas u RAM-u (bez GL poziva); sprites su istim redom kao ulazne putanje
+struct AtlasImage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;  // RGBA8
+    std::vector<AtlasSprite> sprites;
+};
+
+// Dekodira slike i pakuje ih u najmanji atlas (stranice stepen dvojke) u koji staju; false ako se neka slika
+// ne učita ili sve ne staju u maxAtlasSize
+bool buildTextureAtlas(const std::vector<std::string>& paths, const AtlasOptions& options, AtlasImage& atlas);
+
+// GL tekstura atlasa sa mip nivoima 0..2
+unsigned int createAtlasTexture(const AtlasImage& atlas);
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+// Prevođenje slika iz Resources/ u DDS sa S3TC kompresijom i gotovim mip nivoima:
+//   Kostur.exe --compile-textures [slike...]   (bez argumenata: sve .png/.jpg u Resources/)
+// Rezultat je <slika>.dds pored izvorne slike (kao .meshcache za modele). Slike bez providnosti idu u BC1
+// (4 bita po pikselu), ostale u BC3 (8 bita po pikselu); mip nivoi se prave box filtrom u linearnom prostoru do 1x1.
+// Redovi su već okrenuti kao posle decodeTextureImage (prvi red = dno slike, kako GL očekuje).
+//
+// Pri učitavanju se DDS koristi samo ako postoji, odgovara hash-u izvorne slike i GPU podržava S3TC;
+// inače ide dosadašnji put (stbi + glTexImage2D).
+
+// Povećati pri svakoj promeni formata ili kodera
+const uint32_t COMPILED_TEXTURE_VERSION = 2;
+
+struct CompressedMipLevel {
+    int width, height;
+    size_t offset;  // od početka podataka (CompressedTexture::data)
+    size_t size;
+};
+
+// Pročitan DDS – nivoi pokazuju direktno u mapirani fajl
+struct CompressedTexture {
+    MappedFile file;
+    const char* data = nullptr;   // početak blokova (posle zaglavlja)
+    size_t dataSize = 0;
+    unsigned int format = 0;      // GL_COMPRESSED_RGB_S3TC_DXT1_EXT ili GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    std::vector<CompressedMipLevel> levels;
+};
+
+std::string compiledTexturePath(const char* imagePath);
+
+// Prevodi jednu sliku u <imagePath>.dds; vraća false pri grešci
+bool compileTexture(const char* imagePath);
+
+// Ulaz za --compile-textures; vraća 0 ako su sve slike prevedene
+int runTextureCompiler(int argc, char** argv);
+
+// Čita <imagePath>.dds ako postoji i napravljen je od trenutnog sadržaja slike (bez GL poziva)
+bool readCompiledTexture(const char* imagePath, CompressedTexture& texture);
+
+// Da li GPU ume S3TC (proverava se jednom, posle glewInit)
+bool compressedTexturesSupported();
+
+// Pravi GL teksturu sa svim mip nivoima (glCompressedTexImage2D); pixelData = nullptr znači da su blokovi
+// u trenutno vezanom GL_PIXEL_UNPACK_BUFFER-u, na offset-ima iz levels
+unsigned int createCompressedTexture(const CompressedTexture& texture, const char* pixelData);
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "Util.h"
+#include "TextureCompiler.h"
+
+// Učitavanje tekstura bez blokiranja frejma:
+//   1. request() vraća handle odmah; slika se dekodira (stbi + okretanje) na radnoj niti
+//   2. update() (jednom po frejmu, na niti sa GL kontekstom) kopira dekodirane piksele u pixel-unpack
+//      bafer (PBO) iz malog bazena i pokreće glTexSubImage2D iz PBO-a – kopiranje na GPU ide asinhrono
+//   3. kad fence posle upload-a signalizira, tekstura postaje važeća i texture(handle) je vraća
+// Ako postoji važeća prevedena verzija (<slika>.dds, vidi TextureCompiler.h) i GPU podržava S3TC, radna nit
+// umesto dekodiranja samo mapira DDS, a u PBO idu kompresovani blokovi svih mip nivoa.
+// Dok tekstura nije spremna, texture(handle) vraća 0 i pozivalac preskače crtanje (ili crta bez nje).
+// Teksture su deljene i brojane: ista putanja vraća isti handle, a fajl istog sadržaja (hash, npr. claw2.jpg i
+// claw3.jpg) dobija svoj handle koji pokazuje na već učitanu teksturu, bez novog dekodiranja. Svaki request()
+// je jedna referenca; release() je vraća, a GL tekstura se briše kad je pusti poslednji korisnik.
+typedef int TextureHandle;
+const TextureHandle INVALID_TEXTURE_HANDLE = -1;
+
+class TextureStreamer {
+public:
+    // uploadBudget: najviše bajtova koji se po frejmu kopiraju u PBO (bar jedna tekstura se uvek pošalje)
+    explicit TextureStreamer(unsigned int workerCount = 2, size_t uploadBudget = 8u << 20);
+    ~TextureStreamer();
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+    TextureHandle request(const char* filePath);
+    // Vraća referencu iz request(); handle posle poslednjeg release() više ne važi
+    void release(TextureHandle handle);
+
+    // Proverava fence-ove prethodnih upload-a i šalje nove dekodirane slike; ne čeka ni na šta
+    void update();
+
+    // GL tekstura kad je upload završen, inače 0 (i za neuspelo dekodiranje)
+    unsigned int texture(TextureHandle handle) const;
+    bool isReady(TextureHandle handle) const { return texture(handle) != 0; }
+    bool isFailed(TextureHandle handle) const;
+
+    // Procena zauzeća VRAM-a (prevedene: svi mip nivoi; RGB se računa kao RGBA jer ga drajveri tako čuvaju);
+    // deljena tekstura se računa jednom
+    size_t textureBytes(TextureHandle handle) const;
+    size_t totalBytes() const;
+    // Učitane teksture, najveće prve, sa brojem referenci i svim putanjama koje ih dele
+    void printReport() const;
+
+    // Zaustavlja radne niti i briše PBO-e i teksture (mora pre uništavanja GL konteksta)
+    void shutdown();
+
+private:
+    // Shared: isti sadržaj kao ranije zahtevana tekstura (shared), crta se njom; Released: poslednja referenca vraćena
+    enum class State { Decoding, Decoded, Uploading, Ready, Failed, Shared, Released };
+
+    struct Entry {
+        std::string path;
+        State state = State::Decoding;
+        DecodedImage image;
+        CompressedTexture compressed;  // popunjeno umesto image kad se koristi prevedena tekstura
+        unsigned int texture = 0;
+        double requestTime = 0.0;  // glfwGetTime() pri request-u, za log
+
+        uint64_t contentHash = 0;  // 0 dok ga radna nit ne izračuna
+        Entry* shared = nullptr;   // vlasnik teksture za State::Shared
+        int refCount = 1;          // request() pozivi za ovaj handle
+        int sharedCount = 0;       // Shared handle-ovi sa referencama koji koriste ovu teksturu
+        bool orphaned = false;     // sve reference vraćene dok je tekstura još u letu – briše se kad stigne
+        int width = 0, height = 0;
+        size_t bytes = 0;
+        bool compressedFormat = false;
+    };
+
+    struct PixelBuffer {
+        unsigned int buffer = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+        Entry* entry = nullptr;  // nullptr = slobodan
+    };
+
+    void workerLoop();
+    void pollFences();
+    bool uploadEntry(Entry& entry);
+    void finishUpload(Entry& entry, PixelBuffer& target);
+    static size_t uploadSize(const Entry& entry);
+    static const Entry& owner(const Entry& entry) { return entry.shared ? *entry.shared : entry; }
+    // Briše GL teksturu vlasnika kad ga niko više ne koristi (poziva se pod mutex-om)
+    void releaseOwner(Entry& entry);
+
+    std::vector<std::unique_ptr<Entry>> entries;  // handle = indeks
+    std::unordered_map<std::string, TextureHandle> byPath;  // samo glavna nit
+    std::vector<PixelBuffer> pixelBuffers;
+    size_t uploadBudget;
+    bool useCompressed;  // S3TC podrška, pročitana na glavnoj niti u konstruktoru
+
+    // Deljeno sa radnim nitima (pod mutex-om)
+    mutable std::mutex mutex;
+    std::condition_variable decodeSignal;
+    std::deque<Entry*> decodeQueue;
+    std::deque<Entry*> decodedQueue;
+    std::unordered_map<uint64_t, Entry*> byContent;  // vlasnici tekstura po hash-u sadržaja
+    bool stopping = false;
+    std::vector<std::thread> workers;
+};
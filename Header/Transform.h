@@ -0,0 +1,10 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Matrica normala za uM (uNormalMatrix u basic.vert): transpose(inverse(mat3(model))), računa se na CPU jednom po
+// objektu umesto za svaki vertex u sejderu. Za rotaciju + uniformno skaliranje (+ translaciju) inverz nije potreban:
+// tada je rezultat mat3(model) / s², gde je s faktor skaliranja.
+glm::mat3 normalMatrix(const glm::mat4& model);
+
+// true ako je gornji 3x3 deo rotacija (ili ogledanje) pomnožena istim faktorom po svim osama
+bool hasUniformScale(const glm::mat3& linear);
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct Material;
+struct OBJModel;
+struct GLTFModel;
+
+// std140 uniform blokovi iz basic.vert/basic.frag:
+//   FrameBlock    – kamera i svetlo, jednom po frejmu (FrameUniformBuffer)
+//   MaterialBlock – niz svih materijala scene, jednom pri učitavanju (MaterialUniformBuffer); crtanje bira
+//                   materijal samo preko uMaterialIndex
+// Rasporedi C++ struktura moraju da prate deklaracije u sejderima (std140: vec3 zauzima kao vec4).
+
+const unsigned int FRAME_BLOCK_BINDING = 0;
+const unsigned int MATERIAL_BLOCK_BINDING = 1;
+
+// Mora da odgovara MAX_MATERIALS u basic.frag; 256 * 64 B = 16 KB, najmanji GL_MAX_UNIFORM_BLOCK_SIZE
+const unsigned int MAX_MATERIALS = 256;
+
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec4 lightPos;    // w se ne koristi
+    glm::vec4 viewPos;     // w se ne koristi
+    glm::vec4 lightColor;  // w se ne koristi
+};
+static_assert(sizeof(FrameData) == 176, "FrameData mora da prati std140 raspored FrameBlock");
+
+struct MaterialData {
+    glm::vec4 ambient;   // w se ne koristi
+    glm::vec4 diffuse;   // w se ne koristi
+    glm::vec4 specular;  // w = shininess
+    glm::vec4 color;     // boja bez teksture (rgb) i providnost (a)
+};
+static_assert(sizeof(MaterialData) == 64, "MaterialData mora da prati std140 raspored MaterialData u basic.frag");
+
+// Materijal iz .mtl: boja = Kd, providnost = d
+MaterialData makeMaterialData(const Material& material);
+MaterialData makeMaterialData(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular,
+                              float shininess, const glm::vec4& color);
+
+class FrameUniformBuffer {
+public:
+    // Pravi bafer i vezuje ga za FRAME_BLOCK_BINDING
+    void create();
+    void update(const FrameData& frame);
+    void destroy();
+
+private:
+    unsigned int buffer = 0;
+};
+
+class MaterialUniformBuffer {
+public:
+    // Indeks za uMaterialIndex; 0 (prvi materijal) ako je niz pun
+    unsigned int add(const MaterialData& material);
+    // Dodaje sve materijale modela i postavlja model.materialBase
+    void addModel(OBJModel& model);
+    void addModel(GLTFModel& model);
+
+    // Šalje ceo niz na GPU i vezuje bafer za MATERIAL_BLOCK_BINDING (posle svih add/addModel)
+    void upload();
+    void destroy();
+
+    size_t size() const { return materials.size(); }
+
+private:
+    // Indeks prvog dodatog materijala; 0 ako niz nema mesta za sve
+    unsigned int addMaterials(const std::vector<Material>& modelMaterials);
+
+    std::vector<MaterialData> materials;
+    unsigned int buffer = 0;
+};
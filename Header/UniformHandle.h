@@ -0,0 +1,5 @@
+#pragma once
+
+// Handle reflektovane uniforme (indeks u tabeli ShaderProgram-a, ne GL lokacija)
+typedef int UniformHandle;
+const UniformHandle INVALID_UNIFORM_HANDLE = -1;  // uniforma ne postoji (ili je kompajler izbacio); setteri je ignorišu
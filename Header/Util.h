@@ -10,6 +10,29 @@
 #include <cfloat>
 
 int endProgram(std::string message);
-unsigned int createShader(const char* vsSource, const char* fsSource);
+// defines: dodatne linije (npr. "#define UNLIT\n") koje se ubacuju odmah posle #version (vidi ShaderVariants.h)
+unsigned int compileShader(GLenum type, const char* source, const char* defines = nullptr);
+unsigned int createShader(const char* vsSource, const char* fsSource, const char* defines = nullptr);
 unsigned loadImageToTexture(const char* filePath);
-GLFWcursor* loadImageToCursor(const char* filePath);
\ No newline at end of file
+GLFWcursor* loadImageToCursor(const char* filePath);
+
+// Slika dekodirana u RAM (bez GL poziva, pa sme da se pravi na radnoj niti); GL objekat se pravi posle na glavnoj niti
+struct DecodedImage {
+    int width = 0, height = 0, channels = 0;
+    unsigned char* pixels = nullptr;  // stbi bafer, oslobađa se u destruktoru
+
+    DecodedImage() = default;
+    ~DecodedImage();
+    DecodedImage(const DecodedImage&) = delete;
+    DecodedImage& operator=(const DecodedImage&) = delete;
+    DecodedImage(DecodedImage&& other) noexcept;
+    DecodedImage& operator=(DecodedImage&& other) noexcept;
+};
+
+// Dekodira sliku i okreće je uspravno (kao loadImageToTexture)
+bool decodeTextureImage(const char* filePath, DecodedImage& image);
+unsigned createTextureFromImage(const DecodedImage& image);
+
+// Dekodira sliku kursora i smanjuje je na 32x32 RGBA (kao loadImageToCursor)
+bool decodeCursorImage(const char* filePath, DecodedImage& image);
+GLFWcursor* createCursorFromImage(const DecodedImage& image);
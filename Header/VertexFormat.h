@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+#include "UniformHandle.h"
+
+class ShaderProgram;
+
+// Kompaktan vertex format za sve mreže u sceni (16 bajtova umesto 48):
+//   pozicija – unorm16 normalizovana na granice modela (dekvantizacija u basic.vert preko uPosScale/uPosBias)
+//   normala  – oktaedarski kodirana u dva snorm16
+//   UV       – dva half-float-a
+// Konstantna boja (1,1,1,1) se više ne čuva – shader je nikad nije ni čitao.
+struct PackedVertex {
+    uint16_t position[4];  // [3] je samo poravnanje na 8 bajtova
+    int16_t normal[2];
+    uint16_t texCoord[2];
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex mora biti 16 bajtova");
+
+// pos = inPos * scale + bias, gde je inPos u [0, 1]
+struct VertexQuantization {
+    glm::vec3 scale = glm::vec3(1.0f);
+    glm::vec3 bias = glm::vec3(0.0f);
+};
+
+// Najveći broj vertex-a za koji indeksi staju u 16 bita
+const size_t MAX_SHORT_INDEX_VERTICES = 65535;
+
+// Kvantizacija za date granice (prazna osa dobija skalu 1 da dekvantizacija ostane tačna)
+VertexQuantization makeVertexQuantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+
+// Pakovanje jednog vertex-a; pozicije van granica se odsecaju
+PackedVertex packVertex(const glm::vec3& position, const glm::vec2& texCoord, const glm::vec3& normal, const VertexQuantization& quantization);
+
+// Pakuje interleaved vertex-e u rasporedu pos(3) + color(4) + tex(2) + normal(3) (ručno pravljene mreže u Main.cpp);
+// granice se računaju iz samih vertex-a
+std::vector<PackedVertex> packInterleavedVertices(const float* vertices, size_t vertexCount, VertexQuantization& quantization);
+
+glm::vec3 unpackPosition(const PackedVertex& vertex, const VertexQuantization& quantization);
+
+uint16_t floatToHalf(float value);
+void octEncodeNormal(const glm::vec3& normal, int16_t out[2]);
+
+// 32-bitni indeksi -> 16-bitni (pozivalac garantuje da su svi manji od 65536)
+std::vector<uint16_t> narrowIndices(const unsigned int* indices, size_t indexCount);
+
+// GL tip indeksa za veličinu u bajtovima (2 ili 4)
+unsigned int indexTypeForSize(unsigned int indexSize);
+
+// Atributi 0 (pozicija), 2 (UV) i 3 (normala) za trenutno vezani VAO i VBO sa PackedVertex podacima
+void setPackedVertexAttributes();
+
+// Handle-ovi uPosScale/uPosBias (razrešavaju se jednom, posle linkovanja)
+struct VertexQuantizationUniforms {
+    UniformHandle scale = INVALID_UNIFORM_HANDLE;
+    UniformHandle bias = INVALID_UNIFORM_HANDLE;
+};
+VertexQuantizationUniforms findVertexQuantizationUniforms(const ShaderProgram& program);
+
+// Postavlja uPosScale/uPosBias za sledeće crtanje (program mora biti aktivan)
+void setVertexQuantizationUniforms(ShaderProgram& program, const VertexQuantizationUniforms& uniforms, const VertexQuantization& quantization);
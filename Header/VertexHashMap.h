@@ -0,0 +1,85 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Ravna hash tabela sa otvorenim adresiranjem (linearno probanje) za deduplikaciju
+// (pos, tex, norm) trojki pri pravljenju interleaved vertex-a.
+// Ključ je spakovan u 96 bita i čuva se zajedno sa vrednošću u jednom slotu od 16 bajtova,
+// pa jedno traženje/ubacivanje prolazi kroz samo jedan niz probanja bez alokacija po elementu.
+class VertexHashMap {
+public:
+    explicit VertexHashMap(size_t expectedCount) {
+        size_t capacity = 16;
+        while (capacity < expectedCount * 2)  // popunjenost do 50% posle pred-alokacije
+            capacity *= 2;
+        slots.assign(capacity, Slot{ 0, 0, 0, EMPTY });
+        mask = capacity - 1;
+    }
+
+    // Vraća indeks već viđene trojke ili ubacuje newIndex i postavlja inserted = true
+    unsigned int findOrInsert(uint32_t pos, uint32_t tex, uint32_t norm, unsigned int newIndex, bool& inserted) {
+        size_t i = hash(pos, tex, norm) & mask;
+        while (true) {
+            Slot& slot = slots[i];
+            if (slot.value == EMPTY) {
+                slot = Slot{ pos, tex, norm, newIndex };
+                inserted = true;
+                if (++count * 10 > slots.size() * 7)
+                    grow();
+                return newIndex;
+            }
+            if (slot.pos == pos && slot.tex == tex && slot.norm == norm) {
+                inserted = false;
+                return slot.value;
+            }
+            i = (i + 1) & mask;
+        }
+    }
+
+    size_t size() const { return count; }
+
+    // Poziva fn(pos, tex, norm, value) za svaku ubačenu trojku (redosled nije definisan)
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const Slot& slot : slots)
+            if (slot.value != EMPTY)
+                fn(slot.pos, slot.tex, slot.norm, slot.value);
+    }
+
+private:
+    struct Slot {
+        uint32_t pos, tex, norm;
+        uint32_t value;
+    };
+
+    static const uint32_t EMPTY = 0xFFFFFFFFu;
+
+    static size_t hash(uint32_t pos, uint32_t tex, uint32_t norm) {
+        uint64_t h = ((uint64_t)pos | ((uint64_t)tex << 32)) * 0x9E3779B97F4A7C15ull;
+        h ^= (uint64_t)norm * 0xC2B2AE3D27D4EB4Full;
+        h ^= h >> 31;
+        h *= 0xBF58476D1CE4E5B9ull;
+        h ^= h >> 29;
+        return (size_t)h;
+    }
+
+    // Udvostručava tabelu kad procena veličine nije bila dovoljna (popunjenost preko 70%)
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(slots);
+        slots.assign(old.size() * 2, Slot{ 0, 0, 0, EMPTY });
+        mask = slots.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.value == EMPTY) continue;
+            size_t i = hash(slot.pos, slot.tex, slot.norm) & mask;
+            while (slots[i].value != EMPTY)
+                i = (i + 1) & mask;
+            slots[i] = slot;
+        }
+    }
+
+    std::vector<Slot> slots;
+    size_t mask = 0;
+    size_t count = 0;
+};
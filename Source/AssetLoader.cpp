@@ -0,0 +1,107 @@
+#include "../Header/AssetLoader.h"
+#include "../Header/CursorCache.h"
+
+#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void AssetLoader::add(const std::string& name, std::function<void()> work, std::function<void()> upload) {
+    std::unique_ptr<Job> job(new Job());
+    job->name = name;
+    job->work = std::move(work);
+    job->upload = std::move(upload);
+    jobs.push_back(std::move(job));
+}
+
+void AssetLoader::addOBJ(const char* filePath, OBJModel& model, bool optimize) {
+    std::string path = filePath;
+    // Podaci za upload žive između radne i glavne niti
+    std::shared_ptr<OBJUploadData> upload = std::make_shared<OBJUploadData>();
+    std::shared_ptr<bool> ready = std::make_shared<bool>(false);
+    add(path,
+        [this, path, &model, upload, ready, optimize]() {
+            *ready = prepareOBJ(path.c_str(), model, *upload, optimize, ObjParseMode::Auto, parseThreadCount);
+        },
+        [&model, upload, ready]() {
+            if (*ready)
+                uploadPreparedOBJ(model, *upload);
+        });
+}
+
+void AssetLoader::addCursor(const char* filePath, GLFWcursor*& cursor, int size) {
+    std::string path = filePath;
+    std::shared_ptr<CursorImage> image = std::make_shared<CursorImage>();
+    add(path,
+        [path, image, size]() { loadCursorImage(path.c_str(), size, *image); },
+        [&cursor, image]() {
+            cursor = createCursor(*image);
+            *image = CursorImage();
+        });
+}
+
+void AssetLoader::run(unsigned int threadCount) {
+    if (jobs.empty())
+        return;
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t workerCount = std::min<size_t>(threadCount, jobs.size());
+    // Radne niti već dele jezgra, pa svaki .obj dobija svoj deo umesto da pokrene nit po jezgru
+    parseThreadCount = std::max(1u, std::thread::hardware_concurrency() / (unsigned int)workerCount);
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> nextJob(0);
+    std::mutex mutex;
+    std::condition_variable finishedSignal;
+    std::deque<Job*> finished;  // red za upload na glavnoj niti
+
+    // Resursi se dodeljuju redom kojim su dodati – veće (npr. automat) treba dodati prve
+    auto worker = [&]() {
+        for (size_t i = nextJob++; i < jobs.size(); i = nextJob++) {
+            Job& job = *jobs[i];
+            auto jobStart = std::chrono::steady_clock::now();
+            job.work();
+            job.workSeconds = secondsSince(jobStart);
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(&job);
+            finishedSignal.notify_one();
+        }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i)
+        workers.emplace_back(worker);
+
+    // Glavna nit (jedina sa GL kontekstom) pravi GL objekte čim koji resurs stigne
+    double workTotal = 0.0, uploadTotal = 0.0;
+    for (size_t uploaded = 0; uploaded < jobs.size(); ++uploaded) {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            finishedSignal.wait(lock, [&finished]() { return !finished.empty(); });
+            job = finished.front();
+            finished.pop_front();
+        }
+        auto uploadStart = std::chrono::steady_clock::now();
+        job->upload();
+        double uploadSeconds = secondsSince(uploadStart);
+        workTotal += job->workSeconds;
+        uploadTotal += uploadSeconds;
+        std::cout << "Resurs " << job->name << ": ucitavanje " << job->workSeconds * 1000.0 << " ms, GPU upload "
+                  << uploadSeconds * 1000.0 << " ms (spreman posle " << secondsSince(start) * 1000.0 << " ms)" << std::endl;
+    }
+    for (std::thread& thread : workers)
+        thread.join();
+
+    std::cout << "Ucitano " << jobs.size() << " resursa na " << workerCount << " niti za " << secondsSince(start) * 1000.0
+              << " ms (zbir pojedinacnih: ucitavanje " << workTotal * 1000.0 << " ms, upload " << uploadTotal * 1000.0 << " ms)" << std::endl;
+    jobs.clear();
+}
@@ -0,0 +1,452 @@
+#include "../Header/Benchmark.h"
+#include "../Header/Model.h"
+#include "../Header/MappedFile.h"
+#include "../Header/Hash.h"
+#include "../Header/VertexHashMap.h"
+#include "../Header/MeshOptimizer.h"
+#include "../Header/GLTFLoader.h"
+#include "../Header/ImageOps.h"
+#include "../Header/Transform.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <thread>
+
+// Modeli iz Resources/ koje koristi 3D automat
+static const char* benchModelPaths[] = {
+    "Resources/claw_machine.obj",
+    "Resources/claw.obj",
+    "Resources/bearobj.obj",
+    "Resources/rabbit.obj",
+    "Resources/corde pendu.obj",
+};
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Otisak rezultata parsiranja – za proveru da paralelno parsiranje daje iste podatke kao serijsko
+static uint64_t modelFingerprint(const OBJModel& model) {
+    uint64_t hash = hashBytes(model.vertices.data(), model.vertices.size() * sizeof(PackedVertex));
+    hash = hashBytes(model.indices.data(), model.indices.size() * sizeof(unsigned int), hash);
+    return hashBytes(model.ranges.data(), model.ranges.size() * sizeof(MaterialRange), hash);
+}
+
+// Parsira bafer nekoliko puta i ispisuje najbolje vreme kao MB/s i trouglova/s; vraća otisak rezultata.
+// threadCount = 0 meri streaming parsiranje (parseOBJStreaming).
+static uint64_t benchParseBuffer(const char* name, const char* data, size_t size, const std::string& objDir, int repeats, unsigned int threadCount) {
+    double best = 1e30;
+    unsigned int triangles = 0;
+    uint64_t fingerprint = 0;
+    for (int r = 0; r < repeats; ++r) {
+        OBJModel model;
+        std::string mtlPath;
+        auto start = std::chrono::steady_clock::now();
+        if (threadCount == 0)
+            parseOBJStreaming(data, size, objDir, model, mtlPath);
+        else
+            parseOBJBuffer(data, size, objDir, model, mtlPath, threadCount);
+        double elapsed = secondsSince(start);
+        if (elapsed < best) best = elapsed;
+        triangles = model.indexCount / 3;
+        fingerprint = modelFingerprint(model);
+    }
+    double megabytes = (double)size / (1024.0 * 1024.0);
+    std::string mode = threadCount == 0 ? std::string("streaming") : std::to_string(threadCount) + " niti";
+    std::cout << "  " << name << " [" << mode << "]: " << megabytes << " MB, " << triangles << " trouglova, "
+              << best * 1000.0 << " ms -> " << megabytes / best << " MB/s, "
+              << (double)triangles / best / 1.0e6 << " M trouglova/s" << std::endl;
+    return fingerprint;
+}
+
+// Parsira isti bafer sa 1, 2, 4... niti do broja jezgara (i streaming) i proverava da je rezultat svuda isti
+static void benchParseScaling(const char* name, const char* data, size_t size, const std::string& objDir, int repeats) {
+    unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t serial = benchParseBuffer(name, data, size, objDir, repeats, 1);
+    for (unsigned int threads = 2; ; threads *= 2) {
+        if (threads > maxThreads) threads = maxThreads;
+        if (threads <= 1) break;
+        uint64_t parallel = benchParseBuffer(name, data, size, objDir, repeats, threads);
+        if (parallel != serial)
+            std::cout << "  GRESKA: paralelno parsiranje se razlikuje od serijskog!" << std::endl;
+        if (threads == maxThreads) break;
+    }
+    if (benchParseBuffer(name, data, size, objDir, repeats, 0) != serial)
+        std::cout << "  GRESKA: streaming parsiranje se razlikuje od serijskog!" << std::endl;
+}
+
+static void appendFloat(std::string& out, float value) {
+    char buffer[32];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+static void appendIndex(std::string& out, unsigned int value) {
+    char buffer[16];
+    std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
+
+// Sintetički .obj: mreža side x side vertex-a sa v/vt/vn, dva trougla po ćeliji
+static std::string makeSyntheticOBJ(size_t targetTriangles) {
+    size_t side = 2;
+    while (2 * (side - 1) * (side - 1) < targetTriangles) ++side;
+
+    std::string text;
+    text.reserve(side * side * 90 + 2 * (side - 1) * (side - 1) * 40);
+    for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+            float fx = (float)x / (float)(side - 1), fy = (float)y / (float)(side - 1);
+            text += "v ";  appendFloat(text, fx * 10.0f); text += ' ';
+            appendFloat(text, 0.25f * (fx - fy)); text += ' '; appendFloat(text, fy * 10.0f); text += '\n';
+            text += "vt "; appendFloat(text, fx); text += ' '; appendFloat(text, fy); text += '\n';
+            text += "vn 0 1 0\n";
+        }
+    }
+    for (size_t y = 0; y + 1 < side; ++y) {
+        for (size_t x = 0; x + 1 < side; ++x) {
+            unsigned int a = (unsigned int)(y * side + x + 1), b = a + 1;
+            unsigned int c = a + (unsigned int)side, d = c + 1;
+            unsigned int tri[2][3] = { { a, c, b }, { b, c, d } };
+            for (auto& t : tri) {
+                text += 'f';
+                for (unsigned int corner : t) {
+                    text += ' '; appendIndex(text, corner);
+                    text += '/'; appendIndex(text, corner);
+                    text += '/'; appendIndex(text, corner);
+                }
+                text += '\n';
+            }
+        }
+    }
+    return text;
+}
+
+static void benchObjParsing(size_t syntheticTriangles) {
+    std::cout << "== Parsiranje .obj (tokenizacija + deduplikacija) ==" << std::endl;
+    for (const char* path : benchModelPaths) {
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cout << "  " << path << ": nije pronadjen, preskacem" << std::endl;
+            continue;
+        }
+        benchParseScaling(path, file.data(), file.size(), "Resources/", 3);
+    }
+
+    std::cout << "  Generisem sinteticki .obj sa " << syntheticTriangles << " trouglova..." << std::endl;
+    std::string synthetic = makeSyntheticOBJ(syntheticTriangles);
+    benchParseScaling("sinteticki", synthetic.data(), synthetic.size(), "", 1);
+}
+
+// Uglovi trouglova mreže (svaki vertex deli ~6 trouglova, kao kod zatvorenih modela)
+static std::vector<uint32_t> makeGridCorners(size_t cornerCount) {
+    size_t side = 2;
+    while (6 * (side - 1) * (side - 1) < cornerCount) ++side;
+    std::vector<uint32_t> corners;
+    corners.reserve(cornerCount);
+    for (size_t y = 0; y + 1 < side && corners.size() < cornerCount; ++y) {
+        for (size_t x = 0; x + 1 < side && corners.size() < cornerCount; ++x) {
+            uint32_t a = (uint32_t)(y * side + x), b = a + 1, c = a + (uint32_t)side, d = c + 1;
+            uint32_t quad[6] = { a, c, b, b, c, d };
+            for (uint32_t corner : quad)
+                if (corners.size() < cornerCount) corners.push_back(corner);
+        }
+    }
+    return corners;
+}
+
+// Deduplikacija (pos, tex, norm) trojki: stari std::map (find + operator[]) naspram VertexHashMap
+static void benchVertexDedup() {
+    std::cout << "== Deduplikacija vertex-a: std::map naspram VertexHashMap ==" << std::endl;
+    const size_t cornerCounts[] = { 10000, 100000, 1000000, 5000000 };
+    for (size_t cornerCount : cornerCounts) {
+        std::vector<uint32_t> corners = makeGridCorners(cornerCount);
+        // Pozicija i UV dele indeks, normala je po "ćeliji" da trojke ne budu trivijalne
+        auto texOf = [](uint32_t p) { return p; };
+        auto normOf = [](uint32_t p) { return p / 7; };
+
+        auto start = std::chrono::steady_clock::now();
+        std::map<std::tuple<unsigned int, unsigned int, unsigned int>, unsigned int> treeMap;
+        unsigned int treeNext = 0;
+        uint64_t treeSum = 0;
+        for (uint32_t p : corners) {
+            std::tuple<unsigned int, unsigned int, unsigned int> key(p, texOf(p), normOf(p));
+            if (treeMap.find(key) == treeMap.end())
+                treeMap[key] = treeNext++;
+            treeSum += treeMap[key];
+        }
+        double treeTime = secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        VertexHashMap flatMap(corners.size() / 6);
+        unsigned int flatNext = 0;
+        uint64_t flatSum = 0;
+        for (uint32_t p : corners) {
+            bool inserted;
+            flatSum += flatMap.findOrInsert(p, texOf(p), normOf(p), flatNext, inserted);
+            if (inserted) ++flatNext;
+        }
+        double flatTime = secondsSince(start);
+
+        std::cout << "  " << corners.size() << " uglova, " << flatNext << " vertex-a: std::map "
+                  << treeTime * 1000.0 << " ms, VertexHashMap " << flatTime * 1000.0 << " ms (x"
+                  << treeTime / flatTime << ")" << (treeSum != flatSum || treeNext != flatNext ? "  GRESKA: rezultati se razlikuju!" : "")
+                  << std::endl;
+    }
+}
+
+// Optimizacija indeksa posle parsiranja: vreme i ACMR/ATVR pre i posle (optimizeOBJModel ih ispisuje)
+static void benchMeshOptimization(size_t syntheticTriangles) {
+    std::cout << "== Optimizacija za kes vertex-a (Forsyth + overdraw + fetch) ==" << std::endl;
+    auto benchModel = [](const char* name, const char* data, size_t size, const std::string& objDir) {
+        OBJModel model;
+        std::string mtlPath;
+        if (!parseOBJBuffer(data, size, objDir, model, mtlPath))
+            return;
+        auto start = std::chrono::steady_clock::now();
+        optimizeOBJModel(model, name);
+        std::cout << "  " << name << ": " << model.indexCount / 3 << " trouglova, " << secondsSince(start) * 1000.0 << " ms" << std::endl;
+    };
+    for (const char* path : benchModelPaths) {
+        MappedFile file;
+        if (file.open(path))
+            benchModel(path, file.data(), file.size(), "Resources/");
+    }
+    std::string synthetic = makeSyntheticOBJ(syntheticTriangles);
+    benchModel("sinteticki", synthetic.data(), synthetic.size(), "");
+}
+
+// Ista scena kao .glb i kao .obj: GLB se samo mapira i opisuje (BIN blok ide na GPU kakav jeste),
+// a OBJ prolazi kroz tekstualno parsiranje + optimizaciju, odnosno kroz binarni keš kad postoji.
+// Mere se samo CPU delovi (bez GL konteksta); za GPU se ispisuje broj bajtova koji bi se poslao
+// (GPU upload GLB-a ispisuje Kostur.exe --glb pri pokretanju).
+static void benchGLBLoading(int repeats) {
+    std::cout << "== GLB naspram OBJ (ista scena) ==" << std::endl;
+    const char* glbPath = "Resources/bird_in_a_claw_machine.glb";
+    const char* objPath = "Resources/claw_machine.obj";
+
+    double best = 1e30;
+    size_t uploadBytes = 0;
+    unsigned int triangles = 0;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        MappedFile file;
+        GLTFModel model;
+        if (!file.open(glbPath) || !parseGLB(file.data(), file.size(), model)) {
+            std::cout << "  " << glbPath << ": nije pronadjen ili nije ispravan, preskacem" << std::endl;
+            return;
+        }
+        double elapsed = secondsSince(start);
+        if (elapsed < best) best = elapsed;
+        uploadBytes = model.binLength;
+        triangles = model.triangleCount;
+    }
+    std::cout << "  GLB " << glbPath << ": " << best * 1000.0 << " ms, " << triangles << " trouglova, "
+              << uploadBytes / 1024 << " KB za GPU" << std::endl;
+
+    auto printOBJPass = [&](const char* passName, double elapsed, const OBJModel& model) {
+        std::cout << "  " << passName << " " << objPath << ": " << elapsed * 1000.0 << " ms, " << model.indexCount / 3 << " trouglova, "
+                  << ((size_t)model.vertexCount * sizeof(PackedVertex) + (size_t)model.indexCount * model.indexSize) / 1024
+                  << " KB za GPU (x" << elapsed / best << " naspram GLB)" << std::endl;
+    };
+
+    // Bez keša: tekstualno parsiranje + optimizacija, direktno (prepareOBJ bi pročitao .meshcache ako postoji)
+    {
+        auto start = std::chrono::steady_clock::now();
+        MappedFile file;
+        OBJModel model;
+        std::string mtlPath;
+        if (!file.open(objPath) || !parseOBJBuffer(file.data(), file.size(), "Resources/", model, mtlPath)) {
+            std::cout << "  " << objPath << ": nije pronadjen, preskacem" << std::endl;
+            return;
+        }
+        optimizeOBJModel(model, objPath);
+        printOBJPass("OBJ (tekst)", secondsSince(start), model);
+    }
+
+    // Iz keša: prvi poziv upisuje .meshcache ako ga nema, meri se drugi
+    {
+        OBJModel warmModel;
+        OBJUploadData warmUpload;
+        prepareOBJ(objPath, warmModel, warmUpload);
+        auto start = std::chrono::steady_clock::now();
+        OBJModel model;
+        OBJUploadData upload;
+        if (!prepareOBJ(objPath, model, upload))
+            return;
+        printOBJPass("OBJ (iz kesa)", secondsSince(start), model);
+    }
+}
+
+// Jedno jezgro iz ImageOps: isti broj ponavljanja skalarno pa SIMD (jezgra u mestu zato rade nad istim nizom
+// stanja), najbolje vreme od svih; reset vraća ulaz, fingerprint poredi izlaze
+template <typename Reset, typename Run, typename Fingerprint>
+static void benchImageKernel(const char* name, size_t bytes, int repeats, Reset reset, Run run, Fingerprint fingerprint) {
+    double best[2];
+    uint64_t result[2];
+    for (int simd = 0; simd < 2; ++simd) {
+        setImageOpsSimdEnabled(simd != 0);
+        reset();
+        best[simd] = 1e30;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            best[simd] = std::min(best[simd], secondsSince(start));
+        }
+        result[simd] = fingerprint();
+    }
+    setImageOpsSimdEnabled(true);
+    const double megabytes = bytes / (1024.0 * 1024.0);
+    std::cout << "  " << name << ": skalarno " << megabytes / best[0] << " MB/s, " << imageOpsSimdLevel() << " "
+              << megabytes / best[1] << " MB/s (x" << best[0] / best[1] << ")"
+              << (result[0] != result[1] ? "  GRESKA: rezultati se razlikuju!" : "") << std::endl;
+}
+
+// Jezgra koja koriste učitavanje tekstura, kursora i kompajler tekstura, nad sintetičkom slikom 2048x2048
+// (propusnost se računa po ulaznim bajtovima)
+static void benchImageOps(int repeats) {
+    std::cout << "== Obrada slika (ImageOps, " << imageOpsSimdLevel() << ") ==" << std::endl;
+    const int width = 2048, height = 2048;
+    const size_t pixelCount = (size_t)width * height;
+    std::vector<unsigned char> source(pixelCount * 4);
+    uint32_t seed = 12345;
+    for (unsigned char& value : source) {
+        seed = seed * 1664525u + 1013904223u;
+        value = (unsigned char)(seed >> 24);
+    }
+
+    std::vector<unsigned char> rgba(pixelCount * 4), small((size_t)(width / 2) * (height / 2) * 4);
+    std::vector<float> linear(pixelCount * 4), linearSmall(small.size());
+    auto bytesHash = [](const std::vector<unsigned char>& data) {
+        return [&data]() { return hashBytes(data.data(), data.size()); };
+    };
+    auto floatsHash = [](const std::vector<float>& data) {
+        return [&data]() { return hashBytes(data.data(), data.size() * sizeof(float)); };
+    };
+    auto resetRGBA = [&]() { rgba = source; };
+    auto none = []() {};
+
+    benchImageKernel("okretanje redova (RGBA)", pixelCount * 4, repeats, resetRGBA,
+                     [&]() { flipRowsVertical(rgba.data(), width, height, 4); }, bytesHash(rgba));
+    benchImageKernel("RGB -> RGBA", pixelCount * 3, repeats, none,
+                     [&]() { expandToRGBA(source.data(), 3, pixelCount, rgba.data()); }, bytesHash(rgba));
+    benchImageKernel("premultiplied alpha", pixelCount * 4, repeats, resetRGBA,
+                     [&]() { premultiplyAlphaRGBA(rgba.data(), pixelCount); }, bytesHash(rgba));
+    benchImageKernel("sRGB -> linearno", pixelCount * 4, repeats, none,
+                     [&]() { srgbToLinearRGBA(source.data(), pixelCount, linear.data()); }, floatsHash(linear));
+    benchImageKernel("linearno -> sRGB", pixelCount * 4 * sizeof(float), repeats, none,
+                     [&]() { linearToSrgbRGBA(linear.data(), pixelCount, rgba.data()); }, bytesHash(rgba));
+    benchImageKernel("2x umanjenje (RGBA8)", pixelCount * 4, repeats, none,
+                     [&]() { downsample2xRGBA(source.data(), width, height, small.data()); }, bytesHash(small));
+    benchImageKernel("2x umanjenje (linearno)", pixelCount * 4 * sizeof(float), repeats, none,
+                     [&]() { downsample2xLinearRGBA(linear.data(), width, height, linearSmall.data()); }, floatsHash(linearSmall));
+    std::vector<unsigned char> cursor(96 * 96 * 4);
+    benchImageKernel("area resize 2048 -> 96 (kursor)", pixelCount * 4, repeats, none,
+                     [&]() { resizeAreaRGBA(source.data(), width, height, cursor.data(), 96, 96); }, bytesHash(cursor));
+}
+
+// Uniforme jednog crtanja kako ih vidi vertex sejder
+struct VertexStageUniforms {
+    glm::mat4 model;
+    glm::mat4 viewProjection;
+    glm::mat3 normal;
+};
+
+// Vertex faza basic.vert na CPU (glm prati GLSL): clip pozicija i normala za svaki vertex. Uniforme se čitaju kroz
+// pokazivač, a izlaz su float-ovi koji mogu da se preklope sa njima, pa kompajler ne sme da izvuče inverse() iz
+// petlje – isto kao sejder, koji ga računa za svaki vertex.
+template <bool InversePerVertex>
+static void runVertexStage(const VertexStageUniforms* uniforms, const std::vector<glm::vec3>& positions,
+                           const std::vector<glm::vec3>& normals, float* out) {
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const glm::vec4 world = uniforms->model * glm::vec4(positions[i], 1.0f);
+        const glm::vec4 clip = uniforms->viewProjection * world;
+        const glm::mat3 normalMat = InversePerVertex ? glm::mat3(glm::transpose(glm::inverse(uniforms->model))) : uniforms->normal;
+        const glm::vec3 normal = normalMat * normals[i];
+        float* o = out + i * 7;
+        o[0] = clip.x; o[1] = clip.y; o[2] = clip.z; o[3] = clip.w;
+        o[4] = normal.x; o[5] = normal.y; o[6] = normal.z;
+    }
+}
+
+// Matrica normala po vertexu (stari basic.vert) naspram jednom po objektu na CPU (Transform.h), nad sintetičkim
+// mešom veličine zeca/medveda i matricom kao za igračke (translacija, rotacija, uniformno skaliranje).
+// Nema softverskog rasterizera u projektu, pa se meri samo vertex faza – ona je jedina koja se promenila.
+static void benchVertexTransform(size_t vertexCount, int repeats) {
+    std::cout << "== Vertex faza: matrica normala (" << vertexCount << " vertexa) ==" << std::endl;
+    std::vector<glm::vec3> positions(vertexCount), normals(vertexCount);
+    uint32_t seed = 4242;
+    auto nextFloat = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float)(seed >> 8) / 16777216.0f * 2.0f - 1.0f;
+    };
+    for (size_t i = 0; i < vertexCount; ++i) {
+        positions[i] = glm::vec3(nextFloat(), nextFloat(), nextFloat()) * 50.0f;
+        normals[i] = glm::normalize(glm::vec3(nextFloat(), nextFloat(), nextFloat() + 2.0f));
+    }
+
+    VertexStageUniforms uniforms;
+    uniforms.model = glm::translate(glm::mat4(1.0f), glm::vec3(0.2f, -0.3f, 0.1f));
+    uniforms.model = glm::rotate(uniforms.model, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    uniforms.model = glm::scale(uniforms.model, glm::vec3(0.022f));
+    uniforms.viewProjection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f) *
+                              glm::lookAt(glm::vec3(0.0f, 1.0f, 4.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    std::cout << "  uniformno skaliranje: " << (hasUniformScale(glm::mat3(uniforms.model)) ? "da" : "ne") << std::endl;
+
+    const char* names[] = { "inverse() po vertexu", "CPU, opsti inverz", "CPU, uniformno skaliranje" };
+    std::vector<float> reference(vertexCount * 7), out(vertexCount * 7);
+    double best[3];
+    for (int mode = 0; mode < 3; ++mode) {
+        best[mode] = 1e30;
+        for (int r = 0; r < repeats; ++r) {
+            auto start = std::chrono::steady_clock::now();
+            if (mode == 0) {
+                runVertexStage<true>(&uniforms, positions, normals, reference.data());
+            } else {
+                // Jednom po objektu, kao u Main.cpp
+                uniforms.normal = mode == 1 ? glm::transpose(glm::inverse(glm::mat3(uniforms.model))) : normalMatrix(uniforms.model);
+                runVertexStage<false>(&uniforms, positions, normals, out.data());
+            }
+            best[mode] = std::min(best[mode], secondsSince(start));
+        }
+        // Normale se u sejderu normalizuju, pa se porede pravci
+        float maxError = 0.0f;
+        if (mode != 0) {
+            for (size_t i = 0; i < vertexCount; ++i) {
+                const glm::vec3 a = glm::normalize(glm::make_vec3(&reference[i * 7 + 4]));
+                const glm::vec3 b = glm::normalize(glm::make_vec3(&out[i * 7 + 4]));
+                maxError = std::max(maxError, glm::length(a - b));
+            }
+        }
+        std::cout << "  " << names[mode] << ": " << vertexCount / best[mode] / 1e6 << " M vertexa/s";
+        if (mode != 0)
+            std::cout << " (x" << best[0] / best[mode] << ", najveca razlika normale " << maxError << ")";
+        std::cout << std::endl;
+    }
+}
+
+int runBenchmarks(int argc, char** argv) {
+    size_t syntheticTriangles = 10000000;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench-tris") == 0)
+            syntheticTriangles = (size_t)std::stoull(argv[i + 1]);
+    }
+
+    benchVertexDedup();
+    benchObjParsing(syntheticTriangles);
+    benchMeshOptimization(std::min(syntheticTriangles, (size_t)2000000));
+    benchGLBLoading(5);
+    benchImageOps(5);
+    benchVertexTransform(2000000, 5);
+    return 0;
+}
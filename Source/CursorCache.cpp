@@ -0,0 +1,169 @@
+#include "../Header/CursorCache.h"
+#include "../Header/ImageOps.h"
+#include "../Header/MappedFile.h"
+#include "../Header/Hash.h"
+#include "../Header/stb_image.h"
+
+#include <iostream>
+#include <cstring>
+
+// Raspored keš fajla:
+//   CursorCacheHeader
+//   CursorCacheEntry[count]
+//   pikseli svake veličine (size * size * 4 bajta, na offset-u iz tabele)
+struct CursorCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t count;
+    uint32_t reserved;
+};
+
+struct CursorCacheEntry {
+    uint32_t size;
+    uint32_t reserved;
+    uint64_t offset;
+};
+
+static const char cursorCacheMagic[4] = { 'K', 'C', 'U', 'R' };
+
+int cursorSizeForScale(float contentScale) {
+    const float wanted = CURSOR_SIZES[0] * contentScale;
+    for (int i = 0; i < CURSOR_SIZE_COUNT; ++i) {
+        // Mala tolerancija: 1.49 * 32 = 47.7 i dalje bira 48
+        if (CURSOR_SIZES[i] + 0.5f >= wanted)
+            return CURSOR_SIZES[i];
+    }
+    return CURSOR_SIZES[CURSOR_SIZE_COUNT - 1];
+}
+
+std::string cursorCachePath(const char* imagePath) {
+    return std::string(imagePath) + ".cursors";
+}
+
+static bool readCursorCache(const char* imagePath, uint64_t sourceHash, int size, CursorImage& image) {
+    MappedFile cache;
+    if (!cache.open(cursorCachePath(imagePath).c_str()))
+        return false;
+
+    const char* base = cache.data();
+    const size_t fileSize = cache.size();
+    CursorCacheHeader header;
+    if (fileSize < sizeof(header))
+        return false;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, cursorCacheMagic, 4) != 0 || header.version != CURSOR_CACHE_VERSION ||
+        header.sourceHash != sourceHash) {
+        std::cout << "Kes kursora je zastareo: " << imagePath << std::endl;
+        return false;
+    }
+    if (sizeof(header) + (uint64_t)header.count * sizeof(CursorCacheEntry) > fileSize)
+        return false;
+
+    for (uint32_t i = 0; i < header.count; ++i) {
+        CursorCacheEntry entry;
+        std::memcpy(&entry, base + sizeof(header) + i * sizeof(CursorCacheEntry), sizeof(entry));
+        if ((int)entry.size != size)
+            continue;
+        const uint64_t bytes = (uint64_t)size * size * 4;
+        if (entry.offset + bytes > fileSize) {
+            std::cout << "Kes kursora je ostecen: " << imagePath << std::endl;
+            return false;
+        }
+        image.size = size;
+        image.pixels.assign(base + entry.offset, base + entry.offset + bytes);
+        return true;
+    }
+    return false;  // tražena veličina nije u kešu (npr. CURSOR_SIZES je promenjen bez nove verzije)
+}
+
+static bool writeCursorCache(const char* imagePath, uint64_t sourceHash, const std::vector<CursorImage>& images) {
+    CursorCacheHeader header = {};
+    std::memcpy(header.magic, cursorCacheMagic, 4);
+    header.version = CURSOR_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.count = (uint32_t)images.size();
+
+    // Zaglavlje i tabela unosa idu ispred piksela svih veličina redom
+    std::vector<char> table(sizeof(header) + images.size() * sizeof(CursorCacheEntry));
+    std::memcpy(table.data(), &header, sizeof(header));
+    std::vector<unsigned char> pixels;
+    uint64_t offset = table.size();
+    for (size_t i = 0; i < images.size(); ++i) {
+        CursorCacheEntry entry = { (uint32_t)images[i].size, 0, offset };
+        std::memcpy(table.data() + sizeof(header) + i * sizeof(CursorCacheEntry), &entry, sizeof(entry));
+        pixels.insert(pixels.end(), images[i].pixels.begin(), images[i].pixels.end());
+        offset += images[i].pixels.size();
+    }
+
+    std::string path = cursorCachePath(imagePath);
+    if (!writeFileAtomically(path.c_str(), table.data(), table.size(), pixels.data(), pixels.size())) {
+        std::cout << "Greska pri upisu kesa kursora: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Kes kursora upisan: " << path << std::endl;
+    return true;
+}
+
+// Dekodira sliku jednom i pravi sve tražene veličine
+static bool resizeCursorImage(const char* imagePath, const int* sizes, int sizeCount, std::vector<CursorImage>& images) {
+    int width, height, channels;
+    unsigned char* pixels = stbi_load(imagePath, &width, &height, &channels, 4);
+    if (!pixels) {
+        std::cout << "Kursor nije ucitan! " << imagePath << std::endl;
+        return false;
+    }
+    images.resize(sizeCount);
+    for (int i = 0; i < sizeCount; ++i) {
+        images[i].size = sizes[i];
+        images[i].pixels.resize((size_t)sizes[i] * sizes[i] * 4);
+        resizeAreaRGBA(pixels, width, height, images[i].pixels.data(), sizes[i], sizes[i]);
+    }
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool loadCursorImage(const char* imagePath, int size, CursorImage& image) {
+    uint64_t sourceHash = hashFile(imagePath);
+    if (sourceHash == 0) {
+        std::cout << "Kursor nije ucitan! " << imagePath << std::endl;
+        return false;
+    }
+    if (readCursorCache(imagePath, sourceHash, size, image))
+        return true;
+
+    // Veličina van tabele se pravi direktno i ne kešira se
+    bool cached = false;
+    for (int i = 0; i < CURSOR_SIZE_COUNT; ++i)
+        cached = cached || CURSOR_SIZES[i] == size;
+    std::vector<CursorImage> images;
+    if (!cached) {
+        if (!resizeCursorImage(imagePath, &size, 1, images))
+            return false;
+        image = std::move(images[0]);
+        return true;
+    }
+
+    if (!resizeCursorImage(imagePath, CURSOR_SIZES, CURSOR_SIZE_COUNT, images))
+        return false;
+    writeCursorCache(imagePath, sourceHash, images);
+    for (CursorImage& candidate : images) {
+        if (candidate.size == size) {
+            image = std::move(candidate);
+            break;
+        }
+    }
+    return true;
+}
+
+GLFWcursor* createCursor(const CursorImage& image) {
+    if (image.pixels.empty())
+        return nullptr;
+
+    GLFWimage glfwImage;
+    glfwImage.width = image.size;
+    glfwImage.height = image.size;
+    glfwImage.pixels = (unsigned char*)image.pixels.data();
+
+    return glfwCreateCursor(&glfwImage, image.size / 2, image.size / 2);
+}
@@ -0,0 +1,116 @@
+#include "../Header/GLStateCache.h"
+
+#include <GL/glew.h>
+
+static const GLenum capabilityEnums[CAPABILITY_COUNT] = {
+    GL_DEPTH_TEST, GL_CULL_FACE, GL_BLEND, GL_POLYGON_OFFSET_FILL
+};
+
+GLStateCache::GLStateCache() {
+    invalidate();
+}
+
+bool GLStateCache::transition(bool differs) {
+    if (differs)
+        ++frameChanged;
+    else
+        ++frameRedundant;
+    return differs;
+}
+
+void GLStateCache::setCapability(GLCapability capability, bool enabled) {
+    const signed char wanted = enabled ? 1 : 0;
+    if (!transition(capabilities[capability] != wanted))
+        return;
+    capabilities[capability] = wanted;
+    if (enabled)
+        glEnable(capabilityEnums[capability]);
+    else
+        glDisable(capabilityEnums[capability]);
+}
+
+void GLStateCache::blendFunc(unsigned int source, unsigned int destination) {
+    if (!transition(!blendKnown || blendSource != source || blendDestination != destination))
+        return;
+    blendKnown = true;
+    blendSource = source;
+    blendDestination = destination;
+    glBlendFunc(source, destination);
+}
+
+void GLStateCache::polygonOffset(float factor, float units) {
+    if (!transition(!offsetKnown || offsetFactor != factor || offsetUnits != units))
+        return;
+    offsetKnown = true;
+    offsetFactor = factor;
+    offsetUnits = units;
+    glPolygonOffset(factor, units);
+}
+
+void GLStateCache::cullFace(unsigned int mode) {
+    if (!transition(!cullModeKnown || cullMode != mode))
+        return;
+    cullModeKnown = true;
+    cullMode = mode;
+    glCullFace(mode);
+}
+
+void GLStateCache::useProgram(unsigned int id) {
+    if (!transition(!programKnown || program != id))
+        return;
+    programKnown = true;
+    program = id;
+    glUseProgram(id);
+}
+
+void GLStateCache::bindVertexArray(unsigned int id) {
+    if (!transition(!vaoKnown || vao != id))
+        return;
+    vaoKnown = true;
+    vao = id;
+    glBindVertexArray(id);
+}
+
+void GLStateCache::bindTexture2D(unsigned int unit, unsigned int texture) {
+    if (unit >= STATE_CACHE_TEXTURE_UNITS) {
+        transition(true);
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(GL_TEXTURE_2D, texture);
+        activeUnit = unit;
+        return;
+    }
+    if (!transition(!textureKnown[unit] || textures[unit] != texture))
+        return;
+    if (!activeUnitKnown || activeUnit != unit) {
+        activeUnitKnown = true;
+        activeUnit = unit;
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    textureKnown[unit] = true;
+    textures[unit] = texture;
+    glBindTexture(GL_TEXTURE_2D, texture);
+}
+
+void GLStateCache::invalidate() {
+    for (signed char& capability : capabilities)
+        capability = -1;
+    blendKnown = offsetKnown = cullModeKnown = programKnown = false;
+    invalidateBindings();
+}
+
+void GLStateCache::invalidateBindings() {
+    vaoKnown = false;
+    activeUnitKnown = false;
+    for (bool& known : textureKnown)
+        known = false;
+}
+
+void GLStateCache::beginFrame() {
+    if (frameChanged + frameRedundant > 0) {
+        totalChanged += frameChanged;
+        totalRedundant += frameRedundant;
+        ++frames;
+    }
+    frameChanged = frameRedundant = 0;
+    invalidateBindings();
+}
@@ -0,0 +1,576 @@
+#include "../Header/GLTFLoader.h"
+#include "../Header/MappedFile.h"
+#include "../Header/Util.h"
+
+#include <iostream>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <charconv>
+#include <algorithm>
+#include <chrono>
+#include <glm/gtc/quaternion.hpp>
+
+// ---------------------------------------------------------------------------------------------------
+// Minimalan JSON parser – dovoljan za glTF (brojevi, stringovi, nizovi, objekti, true/false/null)
+// ---------------------------------------------------------------------------------------------------
+
+struct JsonValue {
+    enum Type { Null, Bool, Number, String, Array, Object };
+    Type type = Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;                              // Array
+    std::vector<std::pair<std::string, JsonValue>> members;    // Object (redosled iz fajla)
+
+    const JsonValue* find(const char* key) const {
+        if (type != Object) return nullptr;
+        for (const auto& member : members)
+            if (member.first == key) return &member.second;
+        return nullptr;
+    }
+    double numberOr(const char* key, double fallback) const {
+        const JsonValue* value = find(key);
+        return (value && value->type == Number) ? value->number : fallback;
+    }
+    int intOr(const char* key, int fallback) const {
+        return (int)numberOr(key, fallback);
+    }
+    std::string stringOr(const char* key, const char* fallback) const {
+        const JsonValue* value = find(key);
+        return (value && value->type == String) ? value->string : std::string(fallback);
+    }
+    // Niz brojeva tačno zadate dužine (npr. matrix, translation, baseColorFactor)
+    bool numbers(const char* key, float* out, size_t count) const {
+        const JsonValue* value = find(key);
+        if (!value || value->type != Array || value->items.size() != count) return false;
+        for (size_t i = 0; i < count; ++i) {
+            if (value->items[i].type != Number) return false;
+            out[i] = (float)value->items[i].number;
+        }
+        return true;
+    }
+};
+
+class JsonParser {
+public:
+    JsonParser(const char* begin, const char* end) : pos(begin), end(end) {}
+
+    bool parse(JsonValue& value) {
+        if (!parseValue(value, 0)) return false;
+        skipWhitespace();
+        return pos == end;
+    }
+
+private:
+    static const int MAX_DEPTH = 64;
+
+    void skipWhitespace() {
+        while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) ++pos;
+    }
+
+    bool parseLiteral(const char* literal) {
+        size_t length = std::strlen(literal);
+        if ((size_t)(end - pos) < length || std::memcmp(pos, literal, length) != 0) return false;
+        pos += length;
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code) {
+        if (code < 0x80) {
+            out += (char)code;
+        } else if (code < 0x800) {
+            out += (char)(0xC0 | (code >> 6));
+            out += (char)(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += (char)(0xE0 | (code >> 12));
+            out += (char)(0x80 | ((code >> 6) & 0x3F));
+            out += (char)(0x80 | (code & 0x3F));
+        } else {
+            out += (char)(0xF0 | (code >> 18));
+            out += (char)(0x80 | ((code >> 12) & 0x3F));
+            out += (char)(0x80 | ((code >> 6) & 0x3F));
+            out += (char)(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseHex4(uint32_t& code) {
+        if (end - pos < 4) return false;
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = *pos++;
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= (uint32_t)(c - '0');
+            else if (c >= 'a' && c <= 'f') code |= (uint32_t)(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') code |= (uint32_t)(c - 'A' + 10);
+            else return false;
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        ++pos;  // '"'
+        while (pos < end) {
+            // Deo bez escape sekvenci se kopira odjednom
+            const char* run = pos;
+            while (pos < end && *pos != '"' && *pos != '\\') ++pos;
+            out.append(run, pos);
+            if (pos >= end) return false;
+            if (*pos == '"') {
+                ++pos;
+                return true;
+            }
+            ++pos;  // '\\'
+            if (pos >= end) return false;
+            char escaped = *pos++;
+            switch (escaped) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t code;
+                if (!parseHex4(code)) return false;
+                // Surogatni par (znak van BMP-a)
+                if (code >= 0xD800 && code < 0xDC00 && end - pos >= 6 && pos[0] == '\\' && pos[1] == 'u') {
+                    pos += 2;
+                    uint32_t low;
+                    if (!parseHex4(low)) return false;
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, code);
+                break;
+            }
+            default: return false;
+            }
+        }
+        return false;
+    }
+
+    bool parseNumber(double& out) {
+        // from_chars ne prihvata vodeći '+' (kao ni JSON), a '-' prihvata; ne zavisi od lokala
+        std::from_chars_result result = std::from_chars(pos, end, out);
+        if (result.ec != std::errc()) return false;
+        pos = result.ptr;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > MAX_DEPTH) return false;
+        skipWhitespace();
+        if (pos >= end) return false;
+        switch (*pos) {
+        case '{': {
+            value.type = JsonValue::Object;
+            ++pos;
+            skipWhitespace();
+            if (pos < end && *pos == '}') { ++pos; return true; }
+            while (true) {
+                skipWhitespace();
+                if (pos >= end || *pos != '"') return false;
+                value.members.emplace_back();
+                if (!parseString(value.members.back().first)) return false;
+                skipWhitespace();
+                if (pos >= end || *pos != ':') return false;
+                ++pos;
+                if (!parseValue(value.members.back().second, depth + 1)) return false;
+                skipWhitespace();
+                if (pos < end && *pos == ',') { ++pos; continue; }
+                if (pos < end && *pos == '}') { ++pos; return true; }
+                return false;
+            }
+        }
+        case '[': {
+            value.type = JsonValue::Array;
+            ++pos;
+            skipWhitespace();
+            if (pos < end && *pos == ']') { ++pos; return true; }
+            while (true) {
+                value.items.emplace_back();
+                if (!parseValue(value.items.back(), depth + 1)) return false;
+                skipWhitespace();
+                if (pos < end && *pos == ',') { ++pos; continue; }
+                if (pos < end && *pos == ']') { ++pos; return true; }
+                return false;
+            }
+        }
+        case '"':
+            value.type = JsonValue::String;
+            return parseString(value.string);
+        case 't':
+            value.type = JsonValue::Bool;
+            value.boolean = true;
+            return parseLiteral("true");
+        case 'f':
+            value.type = JsonValue::Bool;
+            return parseLiteral("false");
+        case 'n':
+            return parseLiteral("null");
+        default:
+            value.type = JsonValue::Number;
+            return parseNumber(value.number);
+        }
+    }
+
+    const char* pos;
+    const char* end;
+};
+
+// ---------------------------------------------------------------------------------------------------
+// GLB
+// ---------------------------------------------------------------------------------------------------
+
+static const uint32_t GLB_MAGIC = 0x46546C67;       // "glTF"
+static const uint32_t GLB_CHUNK_JSON = 0x4E4F534A;  // "JSON"
+static const uint32_t GLB_CHUNK_BIN = 0x004E4942;   // "BIN\0"
+
+static uint32_t readU32(const char* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static int componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2") return 2;
+    if (type == "VEC3") return 3;
+    if (type == "VEC4") return 4;
+    return 0;
+}
+
+static unsigned int componentSize(unsigned int componentType) {
+    switch (componentType) {
+    case GL_BYTE: case GL_UNSIGNED_BYTE: return 1;
+    case GL_SHORT: case GL_UNSIGNED_SHORT: return 2;
+    case GL_UNSIGNED_INT: case GL_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+// Accessor -> opis atributa u BIN bloku; proverava da svi elementi staju u bufferView i u BIN blok
+static bool readAccessor(const JsonValue& json, int index, size_t binLength, GLTFAttribute& attribute, unsigned int& count) {
+    const JsonValue* accessors = json.find("accessors");
+    const JsonValue* views = json.find("bufferViews");
+    if (!accessors || !views || index < 0 || (size_t)index >= accessors->items.size()) return false;
+    const JsonValue& accessor = accessors->items[index];
+
+    int viewIndex = accessor.intOr("bufferView", -1);
+    if (viewIndex < 0 || (size_t)viewIndex >= views->items.size()) return false;  // sparse/prazni accessor-i nisu podržani
+    const JsonValue& view = views->items[viewIndex];
+    if (view.intOr("buffer", 0) != 0) return false;  // GLB: samo BIN blok
+
+    attribute.components = componentCount(accessor.stringOr("type", ""));
+    attribute.componentType = (unsigned int)accessor.intOr("componentType", 0);
+    attribute.normalized = accessor.find("normalized") && accessor.find("normalized")->boolean;
+    attribute.stride = (unsigned int)view.intOr("byteStride", 0);
+    count = (unsigned int)accessor.numberOr("count", 0);
+    unsigned int elementSize = attribute.components * componentSize(attribute.componentType);
+    if (attribute.components == 0 || elementSize == 0 || count == 0) return false;
+
+    size_t viewOffset = (size_t)view.numberOr("byteOffset", 0);
+    size_t viewLength = (size_t)view.numberOr("byteLength", 0);
+    size_t accessorOffset = (size_t)accessor.numberOr("byteOffset", 0);
+    size_t stride = attribute.stride ? attribute.stride : elementSize;
+    size_t lastByte = accessorOffset + stride * (count - 1) + elementSize;
+    if (viewOffset + viewLength > binLength || lastByte > viewLength) return false;
+    // GL zahteva poravnanje offset-a na veličinu komponente (glTF to garantuje za ispravne fajlove)
+    attribute.offset = viewOffset + accessorOffset;
+    if (attribute.offset % componentSize(attribute.componentType) != 0) return false;
+    attribute.present = true;
+    return true;
+}
+
+// Najveći indeks primitiva, čitan direktno iz BIN bloka (readAccessor je već proverio da svi staju u blok)
+static uint32_t maxIndexValue(const char* indices, unsigned int componentType, unsigned int count) {
+    uint32_t result = 0;
+    for (unsigned int i = 0; i < count; ++i) {
+        uint32_t index;
+        if (componentType == GL_UNSIGNED_BYTE) {
+            index = (unsigned char)indices[i];
+        } else if (componentType == GL_UNSIGNED_SHORT) {
+            uint16_t value;
+            std::memcpy(&value, indices + (size_t)i * 2, sizeof(value));
+            index = value;
+        } else {
+            index = readU32(indices + (size_t)i * 4);
+        }
+        result = std::max(result, index);
+    }
+    return result;
+}
+
+// glTF metallic-roughness -> Phong parametri iz .mtl (Kd, Ka, Ks, Ns, d).
+// Sketchfab izvozi jednobojne (unlit) materijale kao emissiveFactor bez baseColorFactor – tada je to boja.
+static Material convertMaterial(const JsonValue& json) {
+    float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    float emissive[3] = { 0.0f, 0.0f, 0.0f };
+    float metallic = 1.0f, roughness = 1.0f;
+    bool hasBaseColor = false;
+    const JsonValue* pbr = json.find("pbrMetallicRoughness");
+    if (pbr) {
+        hasBaseColor = pbr->numbers("baseColorFactor", baseColor, 4);
+        metallic = (float)pbr->numberOr("metallicFactor", 1.0);
+        roughness = (float)pbr->numberOr("roughnessFactor", 1.0);
+    } else {
+        metallic = 0.0f;  // bez PBR bloka: dielektrik
+    }
+    bool hasEmissive = json.numbers("emissiveFactor", emissive, 3);
+
+    Material mat;
+    mat.Kd = (!hasBaseColor && hasEmissive) ? glm::vec3(emissive[0], emissive[1], emissive[2])
+                                            : glm::vec3(baseColor[0], baseColor[1], baseColor[2]);
+    mat.Ka = glm::vec3(0.2f, 0.2f, 0.2f);  // kao podrazumevani Ka u loadMTL
+    mat.Ks = glm::mix(glm::vec3(0.04f), mat.Kd, metallic);
+    float r4 = std::max(roughness * roughness * roughness * roughness, 1e-4f);
+    mat.Ns = std::min(std::max(2.0f / r4 - 2.0f, 1.0f), 1000.0f);
+    mat.d = (json.stringOr("alphaMode", "OPAQUE") == "BLEND") ? baseColor[3] : 1.0f;
+    return mat;
+}
+
+static glm::mat4 nodeLocalMatrix(const JsonValue& node) {
+    float m[16];
+    if (node.numbers("matrix", m, 16)) {
+        glm::mat4 matrix;
+        std::memcpy(&matrix[0][0], m, sizeof(m));  // glTF i glm su oba column-major
+        return matrix;
+    }
+    float t[3] = { 0.0f, 0.0f, 0.0f }, r[4] = { 0.0f, 0.0f, 0.0f, 1.0f }, s[3] = { 1.0f, 1.0f, 1.0f };
+    node.numbers("translation", t, 3);
+    node.numbers("rotation", r, 4);
+    node.numbers("scale", s, 3);
+    glm::quat rotation(r[3], r[0], r[1], r[2]);  // glTF: xyzw, glm: wxyz
+    return glm::translate(glm::mat4(1.0f), glm::vec3(t[0], t[1], t[2])) * glm::mat4_cast(rotation) *
+           glm::scale(glm::mat4(1.0f), glm::vec3(s[0], s[1], s[2]));
+}
+
+// Računa world matrice od korena naniže; visited štiti od ciklusa u neispravnim fajlovima
+static bool resolveNodeTransforms(GLTFModel& model, int nodeIndex, const glm::mat4& parentWorld, std::vector<char>& visited) {
+    if (nodeIndex < 0 || (size_t)nodeIndex >= model.nodes.size() || visited[nodeIndex])
+        return false;
+    visited[nodeIndex] = 1;
+    GLTFNode& node = model.nodes[nodeIndex];
+    node.world = parentWorld * node.local;
+    if (node.mesh >= 0) {
+        for (const GLTFPrimitive& primitive : model.meshes[node.mesh].primitives)
+            model.triangleCount += (primitive.indexCount ? primitive.indexCount : primitive.vertexCount) / 3;
+    }
+    for (int child : node.children) {
+        if (!resolveNodeTransforms(model, child, node.world, visited))
+            return false;
+        model.nodes[child].parent = nodeIndex;
+    }
+    return true;
+}
+
+bool parseGLB(const char* data, size_t size, GLTFModel& model) {
+    // Zaglavlje: magic, verzija, dužina; zatim JSON blok i (opciono) BIN blok
+    if (size < 20 || readU32(data) != GLB_MAGIC || readU32(data + 4) != 2 || readU32(data + 8) > size) {
+        std::cout << "Greska: nije ispravan GLB 2.0 fajl" << std::endl;
+        return false;
+    }
+    size_t length = readU32(data + 8);
+    size_t jsonLength = readU32(data + 12);
+    if (readU32(data + 16) != GLB_CHUNK_JSON || 20 + jsonLength > length) {
+        std::cout << "Greska: GLB nema JSON blok" << std::endl;
+        return false;
+    }
+    const char* jsonBegin = data + 20;
+    const char* jsonEnd = jsonBegin + jsonLength;
+    // JSON blok je dopunjen razmacima do 4 bajta (neki izvoznici dopunjuju nulama)
+    while (jsonEnd > jsonBegin && jsonEnd[-1] == '\0')
+        --jsonEnd;
+
+    size_t binChunk = 20 + ((jsonLength + 3) & ~(size_t)3);
+    if (binChunk + 8 <= length && readU32(data + binChunk + 4) == GLB_CHUNK_BIN) {
+        model.binOffset = binChunk + 8;
+        model.binLength = std::min<size_t>(readU32(data + binChunk), length - model.binOffset);
+    }
+
+    JsonValue json;
+    JsonParser parser(jsonBegin, jsonEnd);
+    if (!parser.parse(json) || json.type != JsonValue::Object) {
+        std::cout << "Greska: neispravan JSON u GLB fajlu" << std::endl;
+        return false;
+    }
+
+    // Materijali
+    if (const JsonValue* materials = json.find("materials")) {
+        for (const JsonValue& material : materials->items) {
+            model.materials.push_back(convertMaterial(material));
+            model.materialNames.push_back(material.stringOr("name", ""));
+        }
+    }
+
+    // Mreže: samo opis accessor-a, podaci ostaju u BIN bloku
+    if (const JsonValue* meshes = json.find("meshes")) {
+        for (const JsonValue& meshJson : meshes->items) {
+            GLTFMesh mesh;
+            mesh.name = meshJson.stringOr("name", "");
+            const JsonValue* primitives = meshJson.find("primitives");
+            for (size_t p = 0; primitives && p < primitives->items.size(); ++p) {
+                const JsonValue& primitiveJson = primitives->items[p];
+                const JsonValue* attributes = primitiveJson.find("attributes");
+                GLTFPrimitive primitive;
+                primitive.mode = (unsigned int)primitiveJson.intOr("mode", 4);
+                primitive.material = primitiveJson.intOr("material", -1);
+                if (primitive.material >= (int)model.materials.size())
+                    primitive.material = -1;
+
+                unsigned int count = 0;
+                if (!attributes || !readAccessor(json, attributes->intOr("POSITION", -1), model.binLength, primitive.position, count)) {
+                    std::cout << "Greska: primitiv bez ispravnih pozicija u mrezi " << mesh.name << std::endl;
+                    return false;
+                }
+                primitive.vertexCount = count;
+                unsigned int attributeCount = 0;
+                if (attributes->find("NORMAL") &&
+                    (!readAccessor(json, attributes->intOr("NORMAL", -1), model.binLength, primitive.normal, attributeCount) || attributeCount != count))
+                    primitive.normal = GLTFAttribute();
+                if (attributes->find("TEXCOORD_0") &&
+                    (!readAccessor(json, attributes->intOr("TEXCOORD_0", -1), model.binLength, primitive.texCoord, attributeCount) || attributeCount != count))
+                    primitive.texCoord = GLTFAttribute();
+
+                if (primitiveJson.find("indices")) {
+                    GLTFAttribute indices;
+                    if (!readAccessor(json, primitiveJson.intOr("indices", -1), model.binLength, indices, primitive.indexCount) ||
+                        indices.components != 1 || indices.stride != 0 ||
+                        (indices.componentType != GL_UNSIGNED_BYTE && indices.componentType != GL_UNSIGNED_SHORT && indices.componentType != GL_UNSIGNED_INT)) {
+                        std::cout << "Greska: neispravni indeksi u mrezi " << mesh.name << std::endl;
+                        return false;
+                    }
+                    primitive.indexType = indices.componentType;
+                    primitive.indexSize = componentSize(indices.componentType);
+                    primitive.indexOffset = indices.offset;
+                    // Indeks van accessor-a bi GPU čitao van atributa primitiva
+                    if (maxIndexValue(data + model.binOffset + indices.offset, indices.componentType, primitive.indexCount) >= primitive.vertexCount) {
+                        std::cout << "Greska: indeks van opsega vertex-a u mrezi " << mesh.name << std::endl;
+                        return false;
+                    }
+                }
+                mesh.primitives.push_back(primitive);
+            }
+            model.meshes.push_back(std::move(mesh));
+        }
+    }
+
+    // Čvorovi i hijerarhija
+    if (const JsonValue* nodes = json.find("nodes")) {
+        for (const JsonValue& nodeJson : nodes->items) {
+            GLTFNode node;
+            node.name = nodeJson.stringOr("name", "");
+            node.local = nodeLocalMatrix(nodeJson);
+            node.mesh = nodeJson.intOr("mesh", -1);
+            if (node.mesh >= (int)model.meshes.size())
+                node.mesh = -1;
+            if (const JsonValue* children = nodeJson.find("children"))
+                for (const JsonValue& child : children->items)
+                    node.children.push_back((int)child.number);
+            model.nodes.push_back(std::move(node));
+        }
+    }
+
+    // Koreni: čvorovi podrazumevane scene, a bez scene svi čvorovi bez roditelja
+    const JsonValue* scenes = json.find("scenes");
+    int sceneIndex = json.intOr("scene", 0);
+    if (scenes && sceneIndex >= 0 && (size_t)sceneIndex < scenes->items.size()) {
+        if (const JsonValue* sceneNodes = scenes->items[sceneIndex].find("nodes"))
+            for (const JsonValue& root : sceneNodes->items)
+                model.roots.push_back((int)root.number);
+    } else {
+        std::vector<char> isChild(model.nodes.size(), 0);
+        for (const GLTFNode& node : model.nodes)
+            for (int child : node.children)
+                if (child >= 0 && (size_t)child < isChild.size()) isChild[child] = 1;
+        for (size_t i = 0; i < model.nodes.size(); ++i)
+            if (!isChild[i]) model.roots.push_back((int)i);
+    }
+    std::vector<char> visited(model.nodes.size(), 0);
+    for (int root : model.roots) {
+        if (!resolveNodeTransforms(model, root, glm::mat4(1.0f), visited)) {
+            std::cout << "Greska: neispravna hijerarhija cvorova u GLB fajlu" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+static void setGLTFAttribute(unsigned int location, const GLTFAttribute& attribute) {
+    if (!attribute.present) {
+        glDisableVertexAttribArray(location);
+        return;
+    }
+    glVertexAttribPointer(location, attribute.components, attribute.componentType, attribute.normalized ? GL_TRUE : GL_FALSE,
+                          attribute.stride, (void*)attribute.offset);
+    glEnableVertexAttribArray(location);
+}
+
+void uploadGLTFModel(GLTFModel& model, const char* data) {
+    // Ceo BIN blok u jedan bafer – i kao vertex i kao indeksni bafer, bez kopiranja po atributu
+    glGenBuffers(1, &model.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, model.buffer);
+    glBufferData(GL_ARRAY_BUFFER, model.binLength, data + model.binOffset, GL_STATIC_DRAW);
+
+    for (GLTFMesh& mesh : model.meshes) {
+        for (GLTFPrimitive& primitive : mesh.primitives) {
+            glGenVertexArrays(1, &primitive.VAO);
+            glBindVertexArray(primitive.VAO);
+            glBindBuffer(GL_ARRAY_BUFFER, model.buffer);
+            setGLTFAttribute(0, primitive.position);
+            setGLTFAttribute(1, primitive.normal);
+            setGLTFAttribute(2, primitive.texCoord);
+            if (primitive.indexCount > 0)
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.buffer);
+        }
+    }
+    glBindVertexArray(0);
+
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        std::cout << "OpenGL greska pri ucitavanju GLB modela: " << error << std::endl;
+    }
+}
+
+static double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool loadGLB(const char* filePath, GLTFModel& model) {
+    auto start = std::chrono::steady_clock::now();
+    MappedFile file;
+    if (!file.open(filePath)) {
+        std::cout << "Greska pri otvaranju .glb fajla: " << filePath << std::endl;
+        return false;
+    }
+    if (!parseGLB(file.data(), file.size(), model))
+        return false;
+    double parseSeconds = secondsSince(start);
+    auto uploadStart = std::chrono::steady_clock::now();
+    uploadGLTFModel(model, file.data());
+    double uploadSeconds = secondsSince(uploadStart);
+
+    size_t primitiveCount = 0;
+    for (const GLTFMesh& mesh : model.meshes)
+        primitiveCount += mesh.primitives.size();
+    std::cout << "Ucitan GLB " << filePath << ": " << model.nodes.size() << " cvorova, " << model.meshes.size() << " mreza ("
+              << primitiveCount << " primitiva), " << model.materials.size() << " materijala, " << model.triangleCount << " trouglova; parsiranje "
+              << parseSeconds * 1000.0 << " ms, GPU upload " << uploadSeconds * 1000.0 << " ms (" << model.binLength / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+void deleteGLTFModel(GLTFModel& model) {
+    for (GLTFMesh& mesh : model.meshes) {
+        for (GLTFPrimitive& primitive : mesh.primitives) {
+            if (primitive.VAO)
+                glDeleteVertexArrays(1, &primitive.VAO);
+            primitive.VAO = 0;
+        }
+    }
+    if (model.buffer)
+        glDeleteBuffers(1, &model.buffer);
+    model.buffer = 0;
+}
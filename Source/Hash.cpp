@@ -0,0 +1,19 @@
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* p = (const unsigned char*)data;
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t hashFile(const std::string& path) {
+    if (path.empty()) return 0;
+    MappedFile file;
+    if (!file.open(path.c_str())) return 0;
+    return hashBytes(file.data(), file.size());
+}
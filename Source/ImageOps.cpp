@@ -0,0 +1,405 @@
+#include "../Header/ImageOps.h"
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_OPS_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(IMAGE_OPS_SSE2) && defined(__AVX2__)
+#define IMAGE_OPS_AVX2 1
+#include <immintrin.h>
+#endif
+
+static bool simdEnabled = true;
+
+void setImageOpsSimdEnabled(bool enabled) {
+    simdEnabled = enabled;
+}
+
+const char* imageOpsSimdLevel() {
+#if defined(IMAGE_OPS_AVX2)
+    return "AVX2";
+#elif defined(IMAGE_OPS_SSE2)
+    return "SSE2";
+#else
+    return "skalarno";
+#endif
+}
+
+// x * a / 255 sa tačnim zaokruživanjem, bez deljenja (isti izraz koriste i SIMD verzije)
+static inline unsigned char mulDiv255(unsigned int x, unsigned int a) {
+    unsigned int t = x * a + 128;
+    return (unsigned char)((t + (t >> 8)) >> 8);
+}
+
+void flipRowsVertical(unsigned char* pixels, int width, int height, int channels) {
+    const size_t rowBytes = (size_t)width * channels;
+    for (int y = 0; y < height / 2; ++y) {
+        unsigned char* top = pixels + (size_t)y * rowBytes;
+        unsigned char* bottom = pixels + (size_t)(height - 1 - y) * rowBytes;
+        size_t i = 0;
+        if (simdEnabled) {
+#ifdef IMAGE_OPS_AVX2
+            {
+                for (; i + 32 <= rowBytes; i += 32) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*)(top + i));
+                    __m256i b = _mm256_loadu_si256((const __m256i*)(bottom + i));
+                    _mm256_storeu_si256((__m256i*)(top + i), b);
+                    _mm256_storeu_si256((__m256i*)(bottom + i), a);
+                }
+            }
+#endif
+#ifdef IMAGE_OPS_SSE2
+            for (; i + 16 <= rowBytes; i += 16) {
+                __m128i a = _mm_loadu_si128((const __m128i*)(top + i));
+                __m128i b = _mm_loadu_si128((const __m128i*)(bottom + i));
+                _mm_storeu_si128((__m128i*)(top + i), b);
+                _mm_storeu_si128((__m128i*)(bottom + i), a);
+            }
+#endif
+        }
+        for (; i < rowBytes; ++i)
+            std::swap(top[i], bottom[i]);
+    }
+}
+
+void expandToRGBA(const unsigned char* src, int channels, size_t pixelCount, unsigned char* dst) {
+    if (channels == 4) {
+        std::memcpy(dst, src, pixelCount * 4);
+        return;
+    }
+    size_t i = 0;
+    if (channels == 3 && simdEnabled) {
+#ifdef IMAGE_OPS_AVX2
+        {
+            // 8 piksela (24 bajta) po koraku; drugo čitanje ide 4 bajta preko, pa se staje 10 piksela pre kraja
+            const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                     0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const __m256i opaque = _mm256_set1_epi32((int)0xFF000000);
+            for (; i + 10 <= pixelCount; i += 8) {
+                const unsigned char* p = src + i * 3;
+                __m256i rgb = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+                                                      _mm_loadu_si128((const __m128i*)(p + 12)), 1);
+                _mm256_storeu_si256((__m256i*)(dst + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(rgb, shuffle), opaque));
+            }
+        }
+#endif
+#ifdef IMAGE_OPS_SSE2
+        // SSE2 nema pshufb: 4 neporavnata 32-bitna čitanja, a četvrti bajt (R sledećeg piksela) prepisuje alfa
+        const __m128i opaque = _mm_set1_epi32((int)0xFF000000);
+        for (; i + 5 <= pixelCount; i += 4) {
+            const unsigned char* p = src + i * 3;
+            int32_t p0, p1, p2, p3;
+            std::memcpy(&p0, p, 4);
+            std::memcpy(&p1, p + 3, 4);
+            std::memcpy(&p2, p + 6, 4);
+            std::memcpy(&p3, p + 9, 4);
+            _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_or_si128(_mm_setr_epi32(p0, p1, p2, p3), opaque));
+        }
+#endif
+    }
+    for (; i < pixelCount; ++i) {
+        const unsigned char* p = src + i * channels;
+        unsigned char* out = dst + i * 4;
+        out[0] = p[0];
+        out[1] = channels >= 2 ? p[1] : 0;
+        out[2] = channels >= 3 ? p[2] : 0;
+        out[3] = 255;
+    }
+}
+
+#ifdef IMAGE_OPS_SSE2
+// Dva piksela kao 8 x u16: rgb * a / 255, alfa ostaje (množi se sa 255)
+static inline __m128i premultiplyPixels(__m128i x) {
+    const __m128i rgbMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+    const __m128i alphaOne = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xFF), 0xFF);
+    alpha = _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaOne);
+    __m128i t = _mm_add_epi16(_mm_mullo_epi16(x, alpha), _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+#endif
+
+#ifdef IMAGE_OPS_AVX2
+static inline __m256i premultiplyPixels(__m256i x) {
+    const __m256i rgbMask = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+    const __m256i alphaOne = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+    __m256i alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xFF), 0xFF);
+    alpha = _mm256_or_si256(_mm256_and_si256(alpha, rgbMask), alphaOne);
+    __m256i t = _mm256_add_epi16(_mm256_mullo_epi16(x, alpha), _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+}
+#endif
+
+void premultiplyAlphaRGBA(unsigned char* pixels, size_t pixelCount) {
+    size_t i = 0;
+    if (simdEnabled) {
+#ifdef IMAGE_OPS_AVX2
+        {
+            const __m256i zero = _mm256_setzero_si256();
+            for (; i + 8 <= pixelCount; i += 8) {
+                __m256i v = _mm256_loadu_si256((const __m256i*)(pixels + i * 4));
+                __m256i lo = premultiplyPixels(_mm256_unpacklo_epi8(v, zero));
+                __m256i hi = premultiplyPixels(_mm256_unpackhi_epi8(v, zero));
+                _mm256_storeu_si256((__m256i*)(pixels + i * 4), _mm256_packus_epi16(lo, hi));
+            }
+        }
+#endif
+#ifdef IMAGE_OPS_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= pixelCount; i += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(pixels + i * 4));
+            __m128i lo = premultiplyPixels(_mm_unpacklo_epi8(v, zero));
+            __m128i hi = premultiplyPixels(_mm_unpackhi_epi8(v, zero));
+            _mm_storeu_si128((__m128i*)(pixels + i * 4), _mm_packus_epi16(lo, hi));
+        }
+#endif
+    }
+    for (; i < pixelCount; ++i) {
+        unsigned char* p = pixels + i * 4;
+        p[0] = mulDiv255(p[0], p[3]);
+        p[1] = mulDiv255(p[1], p[3]);
+        p[2] = mulDiv255(p[2], p[3]);
+    }
+}
+
+// sRGB konverzije preko tabela: 256 float-ova za dekodiranje i 8192 bajta za kodiranje (linearna vrednost
+// kvantizovana na 13 bita, greška najviše 1 nivo u najtamnijim tonovima). Tabela je brža i od AVX2 gather-a.
+static const int LINEAR_TO_SRGB_STEPS = 8192;
+
+struct SrgbTables {
+    float toLinear[256];
+    unsigned char toSrgb[LINEAR_TO_SRGB_STEPS];
+
+    SrgbTables() {
+        for (int i = 0; i < 256; ++i) {
+            double s = i / 255.0;
+            toLinear[i] = (float)(s <= 0.04045 ? s / 12.92 : std::pow((s + 0.055) / 1.055, 2.4));
+        }
+        for (int i = 0; i < LINEAR_TO_SRGB_STEPS; ++i) {
+            double l = (double)i / (LINEAR_TO_SRGB_STEPS - 1);
+            double s = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+            toSrgb[i] = (unsigned char)std::lround(s * 255.0);
+        }
+    }
+};
+
+static const SrgbTables& srgbTables() {
+    static const SrgbTables tables;
+    return tables;
+}
+
+void srgbToLinearRGBA(const unsigned char* src, size_t pixelCount, float* dst) {
+    const float* toLinear = srgbTables().toLinear;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const unsigned char* p = src + i * 4;
+        float* out = dst + i * 4;
+        out[0] = toLinear[p[0]];
+        out[1] = toLinear[p[1]];
+        out[2] = toLinear[p[2]];
+        out[3] = p[3] * (1.0f / 255.0f);
+    }
+}
+
+void linearToSrgbRGBA(const float* src, size_t pixelCount, unsigned char* dst) {
+    const unsigned char* toSrgb = srgbTables().toSrgb;
+    const float colorScale = (float)(LINEAR_TO_SRGB_STEPS - 1);
+    size_t i = 0;
+    if (simdEnabled) {
+#ifdef IMAGE_OPS_SSE2
+        // Odsecanje, skaliranje i zaokruživanje za sva 4 kanala odjednom; ostaju samo 3 čitanja iz tabele
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 scale = _mm_setr_ps(colorScale, colorScale, colorScale, 255.0f);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        alignas(16) int32_t index[4];
+        for (; i < pixelCount; ++i) {
+            __m128 v = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(src + i * 4), zero), one);
+            _mm_store_si128((__m128i*)index, _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale), half)));
+            unsigned char* out = dst + i * 4;
+            out[0] = toSrgb[index[0]];
+            out[1] = toSrgb[index[1]];
+            out[2] = toSrgb[index[2]];
+            out[3] = (unsigned char)index[3];
+        }
+#endif
+    }
+    for (; i < pixelCount; ++i) {
+        const float* p = src + i * 4;
+        unsigned char* out = dst + i * 4;
+        for (int c = 0; c < 3; ++c)
+            out[c] = toSrgb[(int)(std::min(std::max(p[c], 0.0f), 1.0f) * colorScale + 0.5f)];
+        out[3] = (unsigned char)(int)(std::min(std::max(p[3], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+void downsample2xRGBA(const unsigned char* src, int width, int height, unsigned char* dst) {
+    const int dstWidth = std::max(1, width / 2), dstHeight = std::max(1, height / 2);
+    for (int y = 0; y < dstHeight; ++y) {
+        const unsigned char* row0 = src + (size_t)std::min(2 * y, height - 1) * width * 4;
+        const unsigned char* row1 = src + (size_t)std::min(2 * y + 1, height - 1) * width * 4;
+        unsigned char* out = dst + (size_t)y * dstWidth * 4;
+        int x = 0;
+        // SIMD petlje čitaju samo pune parove (2x + 1 < width), ivična kolona ide skalarno
+        if (simdEnabled && width >= 2) {
+#ifdef IMAGE_OPS_AVX2
+            {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i round = _mm256_set1_epi16(2);
+                for (; x + 4 <= dstWidth; x += 4) {
+                    __m256i a = _mm256_loadu_si256((const __m256i*)(row0 + x * 8));
+                    __m256i b = _mm256_loadu_si256((const __m256i*)(row1 + x * 8));
+                    // Po 128-bitnoj polovini: lo = pikseli 0,1 (4,5), hi = 2,3 (6,7), već sabrani po vertikali
+                    __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+                    __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+                    lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+                    hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+                    __m256i sum = _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi), round), 2);
+                    __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(sum, sum), _MM_SHUFFLE(3, 1, 2, 0));
+                    _mm_storeu_si128((__m128i*)(out + x * 4), _mm256_castsi256_si128(packed));
+                }
+            }
+#endif
+#ifdef IMAGE_OPS_SSE2
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
+            for (; x + 2 <= dstWidth; x += 2) {
+                __m128i a = _mm_loadu_si128((const __m128i*)(row0 + x * 8));
+                __m128i b = _mm_loadu_si128((const __m128i*)(row1 + x * 8));
+                __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+                hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+                __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), round), 2);
+                _mm_storel_epi64((__m128i*)(out + x * 4), _mm_packus_epi16(sum, sum));
+            }
+#endif
+        }
+        for (; x < dstWidth; ++x) {
+            int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = (unsigned char)((row0[x0 * 4 + c] + row0[x1 * 4 + c] + row1[x0 * 4 + c] + row1[x1 * 4 + c] + 2) >> 2);
+        }
+    }
+}
+
+void downsample2xLinearRGBA(const float* src, int width, int height, float* dst) {
+    const int dstWidth = std::max(1, width / 2), dstHeight = std::max(1, height / 2);
+    for (int y = 0; y < dstHeight; ++y) {
+        const float* row0 = src + (size_t)std::min(2 * y, height - 1) * width * 4;
+        const float* row1 = src + (size_t)std::min(2 * y + 1, height - 1) * width * 4;
+        float* out = dst + (size_t)y * dstWidth * 4;
+        for (int x = 0; x < dstWidth; ++x) {
+            int x0 = std::min(2 * x, width - 1), x1 = std::min(2 * x + 1, width - 1);
+            // Isti redosled sabiranja u obe verzije, da rezultat bude identičan
+#ifdef IMAGE_OPS_SSE2
+            if (simdEnabled) {
+                __m128 top = _mm_add_ps(_mm_loadu_ps(row0 + x0 * 4), _mm_loadu_ps(row0 + x1 * 4));
+                __m128 bottom = _mm_add_ps(_mm_loadu_ps(row1 + x0 * 4), _mm_loadu_ps(row1 + x1 * 4));
+                _mm_storeu_ps(out + x * 4, _mm_mul_ps(_mm_add_ps(top, bottom), _mm_set1_ps(0.25f)));
+                continue;
+            }
+#endif
+            for (int c = 0; c < 4; ++c)
+                out[x * 4 + c] = ((row0[x0 * 4 + c] + row0[x1 * 4 + c]) + (row1[x0 * 4 + c] + row1[x1 * 4 + c])) * 0.25f;
+        }
+    }
+}
+
+// Ulazni pikseli koji pokrivaju jedan izlazni (po jednoj osi): indeksi [first, first + count), težine od weightOffset
+struct AreaTaps {
+    std::vector<int> first, count, weightOffset;
+    std::vector<float> weights;
+};
+
+static void buildAreaTaps(int srcSize, int dstSize, AreaTaps& taps) {
+    const double scale = (double)srcSize / dstSize;
+    taps.first.resize(dstSize);
+    taps.count.resize(dstSize);
+    taps.weightOffset.resize(dstSize);
+    taps.weights.clear();
+    for (int d = 0; d < dstSize; ++d) {
+        double start = d * scale, end = (d + 1) * scale;
+        int i0 = (int)std::floor(start);
+        int i1 = std::min(srcSize, (int)std::ceil(end));
+        taps.first[d] = i0;
+        taps.count[d] = i1 - i0;
+        taps.weightOffset[d] = (int)taps.weights.size();
+        for (int i = i0; i < i1; ++i) {
+            double covered = std::min(end, (double)(i + 1)) - std::max(start, (double)i);
+            taps.weights.push_back((float)(covered / scale));
+        }
+    }
+}
+
+// out = sum(weights[k] * pixel[k]), pikseli su float RGBA na razmaku stride float-ova
+static void weightedSum(const float* pixels, size_t stride, const float* weights, int count, float* out) {
+#ifdef IMAGE_OPS_SSE2
+    if (simdEnabled) {
+        __m128 sum = _mm_setzero_ps();
+        for (int k = 0; k < count; ++k)
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixels + k * stride), _mm_set1_ps(weights[k])));
+        _mm_storeu_ps(out, sum);
+        return;
+    }
+#endif
+    float sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for (int k = 0; k < count; ++k)
+        for (int c = 0; c < 4; ++c)
+            sum[c] += pixels[k * stride + c] * weights[k];
+    for (int c = 0; c < 4; ++c)
+        out[c] = sum[c];
+}
+
+// Red RGBA8 u premultiplied float RGBA: premultiplyAlphaRGBA nad kopijom reda (scratch), pa bajtovi u float
+static void premultiplyRow(const unsigned char* src, int width, unsigned char* scratch, float* out) {
+    const size_t count = (size_t)width * 4;
+    std::memcpy(scratch, src, count);
+    premultiplyAlphaRGBA(scratch, (size_t)width);
+    for (size_t i = 0; i < count; ++i)
+        out[i] = scratch[i];
+}
+
+static unsigned char toByte(float value) {
+    return (unsigned char)std::min(std::max(value + 0.5f, 0.0f), 255.0f);
+}
+
+void resizeAreaRGBA(const unsigned char* src, int srcWidth, int srcHeight, unsigned char* dst, int dstWidth, int dstHeight) {
+    AreaTaps horizontal, vertical;
+    buildAreaTaps(srcWidth, dstWidth, horizontal);
+    buildAreaTaps(srcHeight, dstHeight, vertical);
+
+    // Prvo po x (srcHeight redova širine dstWidth), pa po y – razdvojivo, pa je cena O(src + dst) po pikselu a ne proizvod
+    std::vector<unsigned char> scratch((size_t)srcWidth * 4);
+    std::vector<float> row((size_t)srcWidth * 4);
+    std::vector<float> columns((size_t)srcHeight * dstWidth * 4);
+    for (int y = 0; y < srcHeight; ++y) {
+        premultiplyRow(src + (size_t)y * srcWidth * 4, srcWidth, scratch.data(), row.data());
+        float* out = &columns[(size_t)y * dstWidth * 4];
+        for (int x = 0; x < dstWidth; ++x)
+            weightedSum(&row[(size_t)horizontal.first[x] * 4], 4, &horizontal.weights[horizontal.weightOffset[x]],
+                        horizontal.count[x], out + x * 4);
+    }
+
+    const size_t columnStride = (size_t)dstWidth * 4;
+    for (int y = 0; y < dstHeight; ++y) {
+        const float* base = &columns[(size_t)vertical.first[y] * columnStride];
+        const float* weights = &vertical.weights[vertical.weightOffset[y]];
+        for (int x = 0; x < dstWidth; ++x) {
+            float pixel[4];
+            weightedSum(base + x * 4, columnStride, weights, vertical.count[y], pixel);
+            unsigned char* out = dst + ((size_t)y * dstWidth + x) * 4;
+            // Nazad iz premultiplied oblika; potpuno providan piksel nema boju
+            float unpremultiply = pixel[3] > 0.0f ? 255.0f / pixel[3] : 0.0f;
+            out[0] = toByte(pixel[0] * unpremultiply);
+            out[1] = toByte(pixel[1] * unpremultiply);
+            out[2] = toByte(pixel[2] * unpremultiply);
+            out[3] = toByte(pixel[3]);
+        }
+    }
+}
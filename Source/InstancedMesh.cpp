@@ -0,0 +1,60 @@
+#include "../Header/InstancedMesh.h"
+#include "../Header/Model.h"
+
+#include <GL/glew.h>
+
+void InstancedMesh::create(const OBJModel& mesh) {
+    model = &mesh;
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &instanceBuffer);
+    glBindVertexArray(vertexArray);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.VBO);
+    setPackedVertexAttributes();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.EBO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (unsigned int column = 0; column < 4; ++column) {
+        const unsigned int location = INSTANCE_MODEL_ATTRIBUTE + column;
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void*)(offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(location);
+        glVertexAttribDivisor(location, 1);
+    }
+    glVertexAttribPointer(INSTANCE_TINT_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, tint));
+    glEnableVertexAttribArray(INSTANCE_TINT_ATTRIBUTE);
+    glVertexAttribDivisor(INSTANCE_TINT_ATTRIBUTE, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedMesh::add(const glm::mat4& matrix, const glm::vec4& tint) {
+    InstanceData instance;
+    instance.model = matrix;
+    instance.tint = tint;
+    instances.push_back(instance);
+}
+
+void InstancedMesh::upload() {
+    if (instanceBuffer == 0 || instances.empty())
+        return;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    // Bafer raste u koracima po 2x; staro skladište se uvek odbacuje (orphan), pa drajver ne čeka prethodni frejm
+    while (capacity < instances.size())
+        capacity = capacity ? capacity * 2 : 64;
+    glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(InstanceData), instances.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedMesh::destroy() {
+    if (instanceBuffer != 0)
+        glDeleteBuffers(1, &instanceBuffer);
+    if (vertexArray != 0)
+        glDeleteVertexArrays(1, &vertexArray);
+    instanceBuffer = vertexArray = 0;
+    capacity = 0;
+    instances.clear();
+    model = nullptr;
+}
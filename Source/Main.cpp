@@ -20,386 +20,279 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 #include "../Header/Util.h"
+#include "../Header/Model.h"
+#include "../Header/AssetLoader.h"
+#include "../Header/TextureStreamer.h"
+#include "../Header/Benchmark.h"
+#include "../Header/TextureCompiler.h"
+#include "../Header/CursorCache.h"
+#include "../Header/ProgramCache.h"
+#include "../Header/ShaderProgram.h"
+#include "../Header/UniformBlocks.h"
+#include "../Header/ShaderVariants.h"
+#include "../Header/Transform.h"
+#include "../Header/RenderQueue.h"
+#include "../Header/InstancedMesh.h"
+#include "../Header/MultiDraw.h"
+#include "../Header/GLStateCache.h"
+#include "../Header/GLTFLoader.h"
 
-// Struktura za materijal
-struct Material {
-    glm::vec3 Kd;  // Diffuse color
-    glm::vec3 Ka;  // Ambient color
-    glm::vec3 Ks;  // Specular color
-    float Ns;      // Shininess
-    float d;       // Dissolve (alpha)
-};
+// Materijal za opseg; nedostajući materijal (model bez .mtl) vraća nullptr
+static const Material* rangeMaterial(const OBJModel& model, const MaterialRange& range) {
+    return range.materialSlot < model.materials.size() ? &model.materials[range.materialSlot] : nullptr;
+}
 
-// Struktura za čuvanje podataka o .obj modelu
-struct OBJModel {
-    std::vector<float> vertices;  // Interleaved: pos(3) + color(4) + tex(2) + normal(3) = 12 floats
-    std::vector<unsigned int> indices;
-    std::vector<unsigned int> materialIndices;  // Materijal ID za svaki index
-    std::map<std::string, Material> materials;  // Mapa materijala po imenu
-    unsigned int VAO = 0, VBO = 0, EBO = 0;
-    unsigned int indexCount = 0;
+// Handle-ovi uniformi iz basic.vert/basic.frag, razrešeni jednom posle linkovanja (vidi ShaderProgram.h), po varijanti.
+// Kamera, svetlo i materijali su u uniform blokovima (vidi UniformBlocks.h); crtanje menja samo materialIndex.
+struct SceneUniforms {
+    UniformHandle model = INVALID_UNIFORM_HANDLE, normalMatrix = INVALID_UNIFORM_HANDLE;
+    UniformHandle tex = INVALID_UNIFORM_HANDLE, materialIndex = INVALID_UNIFORM_HANDLE;
+    UniformHandle floatNormals = INVALID_UNIFORM_HANDLE;
+    VertexQuantizationUniforms quantization;
+
+    SceneUniforms() = default;
+    explicit SceneUniforms(const ShaderProgram& program)
+        : model(program.uniform("uM")), normalMatrix(program.uniform("uNormalMatrix")),
+          tex(program.uniform("uTex")), materialIndex(program.uniform("uMaterialIndex")),
+          floatNormals(program.uniform("uFloatNormals")), quantization(findVertexQuantizationUniforms(program)) {}
 };
 
-// Funkcija za učitavanje .mtl fajla
-std::map<std::string, Material> loadMTL(const char* mtlPath) {
-    std::map<std::string, Material> materials;
-    Material currentMaterial = {};  // Inicijalizuj na default vrednosti
-    std::string currentMaterialName;
-    
-    std::ifstream file(mtlPath);
-    if (!file.is_open()) {
-        std::cout << "Greska pri otvaranju .mtl fajla: " << mtlPath << std::endl;
-        return materials;
-    }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string type;
-        iss >> type;
-        
-        if (type == "newmtl") {
-            // Sačuvaj prethodni materijal ako postoji
-            if (!currentMaterialName.empty()) {
-                materials[currentMaterialName] = currentMaterial;
-            }
-            // Novi materijal
-            iss >> currentMaterialName;
-            // Resetuj na default vrednosti
-            currentMaterial.Kd = glm::vec3(0.8f, 0.8f, 0.8f);
-            currentMaterial.Ka = glm::vec3(0.2f, 0.2f, 0.2f);
-            currentMaterial.Ks = glm::vec3(0.0f, 0.0f, 0.0f);
-            currentMaterial.Ns = 10.0f;
-            currentMaterial.d = 1.0f;
-        }
-        else if (type == "Kd" && !currentMaterialName.empty()) {
-            iss >> currentMaterial.Kd.r >> currentMaterial.Kd.g >> currentMaterial.Kd.b;
-        }
-        else if (type == "Ka" && !currentMaterialName.empty()) {
-            iss >> currentMaterial.Ka.r >> currentMaterial.Ka.g >> currentMaterial.Ka.b;
-        }
-        else if (type == "Ks" && !currentMaterialName.empty()) {
-            iss >> currentMaterial.Ks.r >> currentMaterial.Ks.g >> currentMaterial.Ks.b;
-        }
-        else if (type == "Ns" && !currentMaterialName.empty()) {
-            iss >> currentMaterial.Ns;
-        }
-        else if (type == "d" && !currentMaterialName.empty()) {
-            iss >> currentMaterial.d;
-        }
-    }
-    
-    // Sačuvaj poslednji materijal
-    if (!currentMaterialName.empty()) {
-        materials[currentMaterialName] = currentMaterial;
-    }
-    
-    file.close();
-    std::cout << "Ucitano " << materials.size() << " materijala iz .mtl fajla!" << std::endl;
-    
-    return materials;
+// uM i matrica normala; normal se prosleđuje kad je već izračunata (npr. za matricu koja se ne menja)
+static void setModelMatrix(ShaderProgram& program, const SceneUniforms& uniforms, const glm::mat4& matrix, const glm::mat3& normal) {
+    program.set(uniforms.model, matrix);
+    program.set(uniforms.normalMatrix, normal);
 }
 
-// Funkcija za učitavanje .obj fajla
-OBJModel loadOBJ(const char* filePath) {
-    OBJModel model;
-    
-    std::vector<glm::vec3> positions;
-    std::vector<glm::vec2> texCoords;
-    std::vector<glm::vec3> normals;
-    std::vector<unsigned int> posIndices, texIndices, normIndices;
-    std::vector<unsigned int> materialIDs;  // Materijal ID za svaki trougao
-    
-    std::string currentMaterial = "";  // Trenutni materijal
-    std::map<std::string, unsigned int> materialNameToID;  // Mapa imena materijala na ID
-    unsigned int nextMaterialID = 0;
-    
-    std::ifstream file(filePath);
-    if (!file.is_open()) {
-        std::cout << "Greska pri otvaranju .obj fajla: " << filePath << std::endl;
-        return model;
-    }
-    
-    std::string mtlFileName = "";
-    std::string objDir = std::string(filePath);
-    size_t lastSlash = objDir.find_last_of("/\\");
-    if (lastSlash != std::string::npos) {
-        objDir = objDir.substr(0, lastSlash + 1);
-    } else {
-        objDir = "";
-    }
-    
-    std::string line;
-    while (std::getline(file, line)) {
-        std::istringstream iss(line);
-        std::string type;
-        iss >> type;
-        
-        if (type == "mtllib") {
-            iss >> mtlFileName;
-            std::string mtlPath = objDir + mtlFileName;
-            model.materials = loadMTL(mtlPath.c_str());
-            // Osiguraj da dno automata uvek ima tamno metalno sivo (floor_metal)
-            if (model.materials.find("floor_metal") == model.materials.end()) {
-                Material floorMat;
-                floorMat.Kd = glm::vec3(0.22f, 0.24f, 0.26f);
-                floorMat.Ka = glm::vec3(0.12f, 0.14f, 0.16f);
-                floorMat.Ks = glm::vec3(0.45f, 0.48f, 0.52f);
-                floorMat.Ns = 100.0f;
-                floorMat.d = 1.0f;
-                model.materials["floor_metal"] = floorMat;
-            }
-            // Kreiraj mapu imena materijala na ID
-            for (const auto& pair : model.materials) {
-                materialNameToID[pair.first] = nextMaterialID++;
-            }
-        }
-        else if (type == "usemtl") {
-            std::string materialName;
-            iss >> materialName;
-            currentMaterial = materialName;
-        }
-        else if (type == "v") {
-            glm::vec3 pos;
-            iss >> pos.x >> pos.y >> pos.z;
-            positions.push_back(pos);
-        }
-        else if (type == "vt") {
-            glm::vec2 tex;
-            iss >> tex.x >> tex.y;
-            texCoords.push_back(tex);
-        }
-        else if (type == "vn") {
-            glm::vec3 norm;
-            iss >> norm.x >> norm.y >> norm.z;
-            normals.push_back(norm);
-        }
-        else if (type == "f") {
-            std::string vertex;
-            std::vector<unsigned int> facePos, faceTex, faceNorm;
-            
-            while (iss >> vertex) {
-                // Parsiranje formata v/vt/vn ili v//vn ili v/vt
-                size_t firstSlash = vertex.find('/');
-                if (firstSlash == std::string::npos) {
-                    // Samo vertex index
-                    unsigned int p = std::stoul(vertex);
-                    facePos.push_back(p - 1);
-                } else {
-                    // Parsiranje v/vt/vn
-                    unsigned int p = std::stoul(vertex.substr(0, firstSlash));
-                    facePos.push_back(p - 1);
-                    
-                    size_t secondSlash = vertex.find('/', firstSlash + 1);
-                    if (secondSlash != std::string::npos) {
-                        // Ima texture i normal
-                        std::string texStr = vertex.substr(firstSlash + 1, secondSlash - firstSlash - 1);
-                        std::string normStr = vertex.substr(secondSlash + 1);
-                        
-                        if (!texStr.empty()) {
-                            unsigned int t = std::stoul(texStr);
-                            faceTex.push_back(t - 1);
-                        }
-                        if (!normStr.empty()) {
-                            unsigned int n = std::stoul(normStr);
-                            faceNorm.push_back(n - 1);
-                        }
-                    } else {
-                        // Samo texture, nema normal
-                        std::string texStr = vertex.substr(firstSlash + 1);
-                        if (!texStr.empty()) {
-                            unsigned int t = std::stoul(texStr);
-                            faceTex.push_back(t - 1);
-                        }
-                    }
-                }
-            }
-            
-            // Triangulacija (pretvaranje kvadova u trouglove)
-            if (facePos.size() >= 3) {
-                // Pronađi materijal ID za trenutni materijal
-                unsigned int matID = 0;  // Default materijal
-                if (!currentMaterial.empty() && materialNameToID.find(currentMaterial) != materialNameToID.end()) {
-                    matID = materialNameToID[currentMaterial];
-                }
-                
-                for (size_t i = 1; i < facePos.size() - 1; ++i) {
-                    posIndices.push_back(facePos[0]);
-                    posIndices.push_back(facePos[i]);
-                    posIndices.push_back(facePos[i + 1]);
-                    
-                    if (!faceTex.empty() && faceTex.size() == facePos.size()) {
-                        texIndices.push_back(faceTex[0]);
-                        texIndices.push_back(faceTex[i]);
-                        texIndices.push_back(faceTex[i + 1]);
-                    }
-                    
-                    if (!faceNorm.empty() && faceNorm.size() == facePos.size()) {
-                        normIndices.push_back(faceNorm[0]);
-                        normIndices.push_back(faceNorm[i]);
-                        normIndices.push_back(faceNorm[i + 1]);
-                    }
-                    
-                    // Dodeli materijal ID za svaki trougao (3 indeksa)
-                    materialIDs.push_back(matID);
-                    materialIDs.push_back(matID);
-                    materialIDs.push_back(matID);
-                }
-            }
+static void setModelMatrix(ShaderProgram& program, const SceneUniforms& uniforms, const glm::mat4& matrix) {
+    setModelMatrix(program, uniforms, matrix, normalMatrix(matrix));
+}
+
+// Varijante basic.vert/basic.frag po klasi crtanja (vidi ShaderVariants.h), sa handle-ovima za svaku
+struct SceneShaders {
+    ShaderVariantCache variants{ "basic.vert", "basic.frag" };
+    SceneUniforms uniforms[SHADER_VARIANT_COUNT];
+
+    // Aktivira varijantu (preko keša stanja); pri prvoj upotrebi je prevodi, vezuje uniform blokove i razrešava handle-ove
+    ShaderProgram& use(ShaderVariant variant, GLStateCache& state) {
+        const bool first = !variants.loaded(variant);
+        ShaderProgram& program = variants.get(variant);
+        state.useProgram(program.id());
+        if (first) {
+            program.bindUniformBlock("FrameBlock", FRAME_BLOCK_BINDING);
+            program.bindUniformBlock("MaterialBlock", MATERIAL_BLOCK_BINDING);
+            uniforms[variant] = SceneUniforms(program);
+            program.set(uniforms[variant].tex, 0);
         }
+        return program;
     }
-    
-    file.close();
-    
-    // Kreiranje interleaved vertex buffer-a
-    std::map<std::tuple<unsigned int, unsigned int, unsigned int>, unsigned int> vertexMap;
-    unsigned int currentIndex = 0;
-    
-    for (size_t i = 0; i < posIndices.size(); ++i) {
-        unsigned int posIdx = posIndices[i];
-        unsigned int texIdx = (i < texIndices.size()) ? texIndices[i] : 0;
-        unsigned int normIdx = (i < normIndices.size()) ? normIndices[i] : 0;
-        
-        std::tuple<unsigned int, unsigned int, unsigned int> key(posIdx, texIdx, normIdx);
-        
-        if (vertexMap.find(key) == vertexMap.end()) {
-            vertexMap[key] = currentIndex++;
-            
-            // Pozicija
-            if (posIdx < positions.size()) {
-                model.vertices.push_back(positions[posIdx].x);
-                model.vertices.push_back(positions[posIdx].y);
-                model.vertices.push_back(positions[posIdx].z);
-            } else {
-                model.vertices.push_back(0.0f);
-                model.vertices.push_back(0.0f);
-                model.vertices.push_back(0.0f);
-            }
-            
-            // Boja (default bela)
-            model.vertices.push_back(1.0f);
-            model.vertices.push_back(1.0f);
-            model.vertices.push_back(1.0f);
-            model.vertices.push_back(1.0f);
-            
-            // Tekstura koordinate
-            if (texIdx < texCoords.size()) {
-                model.vertices.push_back(texCoords[texIdx].x);
-                model.vertices.push_back(texCoords[texIdx].y);
-            } else {
-                model.vertices.push_back(0.0f);
-                model.vertices.push_back(0.0f);
-            }
-            
-            // Normala
-            if (normIdx < normals.size()) {
-                model.vertices.push_back(normals[normIdx].x);
-                model.vertices.push_back(normals[normIdx].y);
-                model.vertices.push_back(normals[normIdx].z);
-            } else {
-                model.vertices.push_back(0.0f);
-                model.vertices.push_back(1.0f);
-                model.vertices.push_back(0.0f);
-            }
-        }
-        
-        model.indices.push_back(vertexMap[key]);
-        // Sačuvaj materijal ID za ovaj index
-        if (i < materialIDs.size()) {
-            model.materialIndices.push_back(materialIDs[i]);
-        } else {
-            model.materialIndices.push_back(0);  // Default materijal
+};
+
+// Indeks materijala opsega u MaterialBlock (model.materialBase postavlja MaterialUniformBuffer::addModel)
+static int rangeMaterialIndex(const OBJModel& model, const MaterialRange& range) {
+    return (int)(model.materialBase + range.materialSlot);
+}
+
+// Delovi automata razvrstani jednom posle učitavanja, da frejm ne poredi imena materijala
+struct MachineParts {
+    std::vector<MaterialRange> opaque;       // neprozirni delovi kućišta
+    std::vector<MaterialRange> doubleSided;  // dno (skin, floor_metal) – obe strane, da se dno uvek vidi
+    std::vector<MaterialRange> claw;         // kandža (pink), pomera se sa clawX/clawY/clawZ
+    std::vector<MaterialRange> glass;        // providni delovi
+};
+
+// Uloga dela automata po imenu materijala; .obj i .glb verzija scene koriste ista imena
+enum MachinePart { MACHINE_PART_HIDDEN, MACHINE_PART_OPAQUE, MACHINE_PART_DOUBLE_SIDED, MACHINE_PART_CLAW, MACHINE_PART_GLASS };
+
+static MachinePart classifyMachineMaterial(const std::string& name, const Material& mat) {
+    if (mat.d < 1.0f) return MACHINE_PART_GLASS;
+    if (name == "pink_frame" || name == "black") return MACHINE_PART_HIDDEN;
+    if (name == "bird" || name == "bird_red") return MACHINE_PART_HIDDEN;  // pticu ne crtamo uopšte
+    if (name == "pink") return MACHINE_PART_CLAW;
+    if (name == "skin" || name == "floor_metal") return MACHINE_PART_DOUBLE_SIDED;
+    return MACHINE_PART_OPAQUE;
+}
+
+static MachineParts classifyMachineParts(const OBJModel& machine) {
+    MachineParts parts;
+    for (const MaterialRange& range : machine.ranges) {
+        const Material* mat = rangeMaterial(machine, range);
+        if (!mat) continue;
+        switch (classifyMachineMaterial(machine.materialNames[range.materialSlot], *mat)) {
+        case MACHINE_PART_OPAQUE: parts.opaque.push_back(range); break;
+        case MACHINE_PART_DOUBLE_SIDED: parts.doubleSided.push_back(range); break;
+        case MACHINE_PART_CLAW: parts.claw.push_back(range); break;
+        case MACHINE_PART_GLASS: parts.glass.push_back(range); break;
+        default: break;
         }
     }
-    
-    model.indexCount = (unsigned int)model.indices.size();
-    
-    // Provera da li ima dovoljno podataka
-    if (model.vertices.empty() || model.indices.empty()) {
-        std::cout << "Greska: Model nema podataka!" << std::endl;
-        std::cout << "Vertices: " << model.vertices.size() << ", Indices: " << model.indices.size() << std::endl;
-        return model;
+    return parts;
+}
+
+static DrawItem makeRangeItem(const OBJModel& model, const MaterialRange& range, uint32_t transform,
+                              RenderPass pass, ShaderVariant program, uint8_t state = 0) {
+    DrawItem item;
+    item.pass = (uint8_t)pass;
+    item.program = (uint8_t)program;
+    item.state = state;
+    item.transform = transform;
+    item.vao = model.VAO;
+    item.indexType = model.indexType;
+    item.indexSize = model.indexSize;
+    item.first = range.first;
+    item.count = range.count;
+    item.quantization = &model.quantization;
+    item.material = rangeMaterialIndex(model, range);
+    return item;
+}
+
+static void submitRanges(RenderQueue& queue, const OBJModel& model, const std::vector<MaterialRange>& ranges, uint32_t transform,
+                         RenderPass pass, ShaderVariant program, uint8_t state = 0) {
+    for (const MaterialRange& range : ranges)
+        queue.submit(makeRangeItem(model, range, transform, pass, program, state));
+}
+
+// Opsezi automata: jedna stavka za ceo batch kad je multi-draw dostupan, inače stavka po opsegu
+static void submitMachineRanges(RenderQueue& queue, const OBJModel& model, const std::vector<MaterialRange>& ranges,
+                                const MultiDrawBatch& batch, uint32_t transform, RenderPass pass, uint8_t state = 0) {
+    const bool transparent = pass == RENDER_PASS_TRANSPARENT;
+    if (!batch.valid()) {
+        submitRanges(queue, model, ranges, transform, pass, transparent ? SHADER_VARIANT_TRANSPARENT_LIT : SHADER_VARIANT_OPAQUE_LIT, state);
+        return;
     }
-    
-    // Kreiranje VAO, VBO, EBO
-    glGenVertexArrays(1, &model.VAO);
-    glGenBuffers(1, &model.VBO);
-    glGenBuffers(1, &model.EBO);
-    
-    glBindVertexArray(model.VAO);
-    
-    glBindBuffer(GL_ARRAY_BUFFER, model.VBO);
-    glBufferData(GL_ARRAY_BUFFER, model.vertices.size() * sizeof(float), model.vertices.data(), GL_STATIC_DRAW);
-    
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, model.indices.size() * sizeof(unsigned int), model.indices.data(), GL_STATIC_DRAW);
-    
-    unsigned int stride = 12 * sizeof(float);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(7 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(10 * sizeof(float)));
-    glEnableVertexAttribArray(3);
-    
-    glBindVertexArray(0);
-    
-    // Provera OpenGL greške
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR) {
-        std::cout << "OpenGL greska pri ucitavanju modela: " << error << std::endl;
+    DrawItem item;
+    item.pass = (uint8_t)pass;
+    item.program = (uint8_t)(transparent ? SHADER_VARIANT_TRANSPARENT_LIT_MULTIDRAW : SHADER_VARIANT_OPAQUE_LIT_MULTIDRAW);
+    item.state = state;
+    item.transform = transform;
+    item.vao = batch.vao();
+    item.quantization = &model.quantization;
+    item.multiDraw = &batch;
+    queue.submit(item);
+}
+
+// OBJ model na datoj matrici (samo neprozirni materijali)
+static void submitOBJModel(RenderQueue& queue, const OBJModel& model, const glm::mat4& matrix) {
+    if (model.indexCount == 0) return;
+    const uint32_t transform = queue.addTransform(matrix);
+    for (const MaterialRange& range : model.ranges) {
+        const Material* mat = rangeMaterial(model, range);
+        if (!mat || mat->d < 1.0f) continue;
+        queue.submit(makeRangeItem(model, range, transform, RENDER_PASS_OPAQUE, SHADER_VARIANT_OPAQUE_LIT));
     }
-    
-    std::cout << "Uspesno ucitano " << model.indexCount / 3 << " trouglova iz .obj fajla!" << std::endl;
-    std::cout << "Broj vertex-a: " << model.vertices.size() / 12 << std::endl;
-    
-    return model;
 }
 
-// Crtanje OBJ modela na datoj matrici (samo neprozirni materijali)
-static void drawOBJModel(const OBJModel& model, const glm::mat4& matrix, unsigned int modelLoc, unsigned int shader) {
-    if (model.indices.empty()) return;
-    std::map<unsigned int, std::vector<std::pair<size_t, size_t>>> materialRanges;
-    unsigned int currentMatID = (model.materialIndices.size() > 0) ? model.materialIndices[0] : 0;
-    size_t rangeStart = 0;
-    for (size_t i = 0; i < model.indices.size(); ++i) {
-        unsigned int matID = (i < model.materialIndices.size()) ? model.materialIndices[i] : 0;
-        if (matID != currentMatID) {
-            if (i > rangeStart)
-                materialRanges[currentMatID].push_back(std::make_pair(rangeStart, i - rangeStart));
-            currentMatID = matID;
-            rangeStart = i;
+// Statični delovi automata iz .glb scene (Kostur.exe --glb): stavka po primitivu, na world matrici svog čvora.
+// Kandža se i dalje crta iz .obj (pomera se), pa se primitivi sa njenim materijalom preskaču, kao i skriveni delovi.
+static void submitGLTFMachine(RenderQueue& queue, const GLTFModel& model, const glm::mat4& machineMatrix) {
+    static const VertexQuantization floatPositions;  // pozicije nisu kvantizovane
+    for (const GLTFNode& node : model.nodes) {
+        if (node.mesh < 0) continue;
+        uint32_t transform = UINT32_MAX;
+        for (const GLTFPrimitive& primitive : model.meshes[node.mesh].primitives) {
+            if (primitive.VAO == 0 || primitive.indexCount == 0 || primitive.mode != GL_TRIANGLES) continue;
+            MachinePart part = MACHINE_PART_OPAQUE;  // primitiv bez materijala
+            if (primitive.material >= 0)
+                part = classifyMachineMaterial(model.materialNames[primitive.material], model.materials[primitive.material]);
+            if (part == MACHINE_PART_HIDDEN || part == MACHINE_PART_CLAW) continue;
+            if (transform == UINT32_MAX)
+                transform = queue.addTransform(machineMatrix * node.world);
+            DrawItem item;
+            item.pass = (uint8_t)(part == MACHINE_PART_GLASS ? RENDER_PASS_TRANSPARENT : RENDER_PASS_OPAQUE);
+            item.program = (uint8_t)(part == MACHINE_PART_GLASS ? SHADER_VARIANT_TRANSPARENT_LIT : SHADER_VARIANT_OPAQUE_LIT);
+            item.state = (uint8_t)(part == MACHINE_PART_DOUBLE_SIDED ? RENDER_STATE_DOUBLE_SIDED : 0);
+            item.transform = transform;
+            item.vao = primitive.VAO;
+            item.indexType = primitive.indexType;
+            item.indexSize = primitive.indexSize;
+            item.first = (unsigned int)(primitive.indexOffset / primitive.indexSize);
+            item.count = primitive.indexCount;
+            item.quantization = &floatPositions;
+            item.material = (int)model.materialBase + std::max(primitive.material, 0);
+            item.floatNormals = true;
+            queue.submit(item);
         }
     }
-    if (model.indices.size() > rangeStart)
-        materialRanges[currentMatID].push_back(std::make_pair(rangeStart, model.indices.size() - rangeStart));
-    std::map<unsigned int, std::string> matIDToName;
-    unsigned int id = 0;
-    for (const auto& pair : model.materials)
-        matIDToName[id++] = pair.first;
-    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(matrix));
-    glUniform1i(glGetUniformLocation(shader, "transparent"), 0);
-    glUniform1i(glGetUniformLocation(shader, "useTex"), 0);
-    glBindVertexArray(model.VAO);
-    for (const auto& group : materialRanges) {
-        std::string matName = (matIDToName.find(group.first) != matIDToName.end()) ? matIDToName[group.first] : "";
-        const Material* mat = nullptr;
-        if (model.materials.find(matName) != model.materials.end())
-            mat = &model.materials.at(matName);
-        if (!mat && !model.materials.empty())
-            mat = &model.materials.begin()->second;
+}
+
+// Sve instance modela, jedna stavka po neprozirnom materijalu; transform se u INSTANCED varijanti ne koristi
+static void submitInstancedMesh(RenderQueue& queue, InstancedMesh& instances, uint32_t transform) {
+    const OBJModel* model = instances.mesh();
+    if (!model || instances.instanceCount() == 0) return;
+    instances.upload();
+    for (const MaterialRange& range : model->ranges) {
+        const Material* mat = rangeMaterial(*model, range);
         if (!mat || mat->d < 1.0f) continue;
-        glUniform3f(glGetUniformLocation(shader, "uMaterialAmbient"), mat->Ka.r, mat->Ka.g, mat->Ka.b);
-        glUniform3f(glGetUniformLocation(shader, "uMaterialDiffuse"), mat->Kd.r, mat->Kd.g, mat->Kd.b);
-        glUniform3f(glGetUniformLocation(shader, "uMaterialSpecular"), mat->Ks.r, mat->Ks.g, mat->Ks.b);
-        glUniform1f(glGetUniformLocation(shader, "uMaterialShininess"), mat->Ns);
-        glUniform4f(glGetUniformLocation(shader, "uColor"), mat->Kd.r, mat->Kd.g, mat->Kd.b, 1.0f);
-        for (const auto& range : group.second)
-            glDrawElements(GL_TRIANGLES, (unsigned int)range.second, GL_UNSIGNED_INT, (void*)(range.first * sizeof(unsigned int)));
+        DrawItem item = makeRangeItem(*model, range, transform, RENDER_PASS_OPAQUE, SHADER_VARIANT_OPAQUE_LIT_INSTANCED);
+        item.vao = instances.vao();
+        item.instanceCount = (unsigned int)instances.instanceCount();
+        queue.submit(item);
     }
-    glBindVertexArray(0);
+}
+
+// Raster stanje koje zavisi od tastera 1–4 i od toga da li kandža nosi igračku
+struct RenderSettings {
+    bool depthTest;
+    bool cullFace;
+    float polygonOffset;  // za RENDER_PASS_OPAQUE_OFFSET (factor i units)
+};
+
+// Izvršava sortiran red; GL stanje ide kroz keš (menja se samo kad se razlikuje, i između frejmova), a uniforme
+// transformacije i kvantizacije se postavljaju samo kad se razlikuju od prethodne stavke
+static void executeRenderQueue(const RenderQueue& queue, SceneShaders& shaders, GLStateCache& state, const RenderSettings& settings) {
+    int pass = -1, program = -1;
+    uint32_t transform = UINT32_MAX;
+    const VertexQuantization* quantization = nullptr;
+    ShaderProgram* active = nullptr;
+    const SceneUniforms* uniforms = nullptr;
+
+    state.setCapability(CAPABILITY_BLEND, true);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    for (size_t i = 0; i < queue.size(); ++i) {
+        const DrawItem& item = queue.sorted(i);
+        if (item.pass != pass) {
+            pass = item.pass;
+            state.setCapability(CAPABILITY_DEPTH_TEST, pass != RENDER_PASS_OVERLAY && settings.depthTest);
+            state.setCapability(CAPABILITY_POLYGON_OFFSET_FILL, pass == RENDER_PASS_OPAQUE_OFFSET);
+            if (pass == RENDER_PASS_OPAQUE_OFFSET)
+                state.polygonOffset(settings.polygonOffset, settings.polygonOffset);
+        }
+        // Providni delovi i overlay se uvek crtaju sa obe strane
+        state.setCapability(CAPABILITY_CULL_FACE,
+                            settings.cullFace && pass <= RENDER_PASS_OPAQUE_OFFSET && !(item.state & RENDER_STATE_DOUBLE_SIDED));
+        if (item.program != program) {
+            program = item.program;
+            active = &shaders.use((ShaderVariant)program, state);
+            uniforms = &shaders.uniforms[program];
+            transform = UINT32_MAX;
+            quantization = nullptr;
+        }
+        state.bindVertexArray(item.vao);
+        if (item.texture != 0)
+            state.bindTexture2D(0, item.texture);
+        if (item.quantization != quantization) {
+            quantization = item.quantization;
+            setVertexQuantizationUniforms(*active, uniforms->quantization, *quantization);
+        }
+        if (item.transform != transform) {
+            transform = item.transform;
+            const DrawTransform& t = queue.transform(transform);
+            setModelMatrix(*active, *uniforms, t.model, t.normal);
+        }
+        active->set(uniforms->floatNormals, item.floatNormals ? 1 : 0);
+        if (item.multiDraw) {
+            item.multiDraw->draw();
+            continue;
+        }
+        active->set(uniforms->materialIndex, item.material);
+        const void* indexOffset = (void*)((size_t)item.first * item.indexSize);
+        if (item.instanceCount > 0)
+            glDrawElementsInstanced(GL_TRIANGLES, item.count, item.indexType, indexOffset, item.instanceCount);
+        else
+            glDrawElements(GL_TRIANGLES, item.count, item.indexType, indexOffset);
+    }
+    state.bindVertexArray(0);
+    state.setCapability(CAPABILITY_POLYGON_OFFSET_FILL, false);
+    state.setCapability(CAPABILITY_DEPTH_TEST, settings.depthTest);
 }
 
 // Globalne promenljive za kontrolu kamere
@@ -577,8 +470,63 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset)
     if (cameraDistance > 10.0f) cameraDistance = 10.0f;
 }
 
-int main(void)
+// Stres test (Kostur.exe --stress-toys N): dno automata se puni sa N igračaka, naizmenično medved i zec
+struct StressToy {
+    bool rabbit;
+    glm::mat4 matrix;
+    glm::vec4 tint;
+};
+
+// Mreža preko poda sa nasumičnom rotacijom i bojom; igračke se smanjuju kad ih je više, da stanu u ćeliju
+static std::vector<StressToy> makeStressToys(int count, float bearScale, float rabbitScale) {
+    std::vector<StressToy> toys;
+    if (count <= 0) return toys;
+    toys.reserve(count);
+    const int columns = (int)std::ceil(std::sqrt((float)count));
+    const float cellX = (playFloorMaxX - playFloorMinX) / columns;
+    const float cellZ = (playFloorMaxZ - playFloorMinZ) / columns;
+    const float shrink = std::min(1.0f, 4.0f / columns);
+    uint32_t seed = 777;
+    auto nextFloat = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (float)(seed >> 8) / 16777216.0f;
+    };
+    for (int i = 0; i < count; ++i) {
+        StressToy toy;
+        toy.rabbit = (i & 1) != 0;
+        const float x = playFloorMinX + (i % columns + 0.5f) * cellX;
+        const float z = playFloorMinZ + (i / columns + 0.5f) * cellZ;
+        const float scale = (toy.rabbit ? rabbitScale : bearScale) * shrink;
+        toy.matrix = glm::translate(glm::mat4(1.0f), glm::vec3(x, toyFloorY, z));
+        toy.matrix = glm::rotate(toy.matrix, nextFloat() * glm::radians(360.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        toy.matrix = glm::scale(toy.matrix, glm::vec3(scale));
+        toy.tint = glm::vec4(0.6f + 0.4f * nextFloat(), 0.6f + 0.4f * nextFloat(), 0.6f + 0.4f * nextFloat(), 1.0f);
+        toys.push_back(toy);
+    }
+    return toys;
+}
+
+int main(int argc, char** argv)
 {
+    // Merenja performansi se pokreću bez prozora: Kostur.exe --bench
+    if (argc > 1 && std::string(argv[1]) == "--bench")
+        return runBenchmarks(argc, argv);
+    // Prevođenje tekstura u DDS (BC1/BC3 + mip nivoi): Kostur.exe --compile-textures [slike...]
+    if (argc > 1 && std::string(argv[1]) == "--compile-textures")
+        return runTextureCompiler(argc, argv);
+    // Stres test crtanja igračaka: Kostur.exe --stress-toys N (u petlji: +/- duplira/polovi N, I = instancirano/pojedinačno)
+    int stressToyCount = 0;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--stress-toys")
+            stressToyCount = std::max(0, std::atoi(argv[i + 1]));
+    }
+    // Kućište automata iz .glb umesto iz .obj (zero-copy učitavanje, vidi GLTFLoader.h): Kostur.exe --glb
+    bool useGLBMachine = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--glb")
+            useGLBMachine = true;
+    }
+
     if (!glfwInit())
     {
         std::cout<<"GLFW Biblioteka se nije ucitala! :(\n";
@@ -624,26 +572,57 @@ int main(void)
     
     std::cout << "Prozor kreiran i OpenGL inicijalizovan!" << std::endl;
     
-    // Kursori: coin kad je automat isključen (početak, posle preuzimanja igračke), poluga kad je uključen
-    GLFWcursor* cursorCoin = loadImageToCursor("Resources/coin.png");
-    GLFWcursor* cursorLever = loadImageToCursor("Resources/poluga.png");
-    glfwSetCursor(window, cursorCoin);  // na početku svetlo je ugašeno
-    
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glEnable(GL_DEPTH_TEST); // Uključeno testiranje dubine (taster 1/2 ga uključuje/isključuje)
-    glCullFace(GL_BACK);     // Kada je uključeno odstranjivanje naličja (taster 3), uklanjaju se zadnja lica
+    // Sve promene GL stanja u petlji idu kroz keš, koji preskače pozive koji ništa ne menjaju (vidi GLStateCache.h)
+    GLStateCache glState;
+    glState.setCapability(CAPABILITY_BLEND, true);
+    glState.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glState.setCapability(CAPABILITY_DEPTH_TEST, true); // Uključeno testiranje dubine (taster 1/2 ga uključuje/isključuje)
+    glState.cullFace(GL_BACK);                           // Kada je uključeno odstranjivanje naličja (taster 3), uklanjaju se zadnja lica
 
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ KREIRANJE 3D MODELA +++++++++++++++++++++++++++++++++++++++++++++++++
     
-    unsigned int unifiedShader = createShader("basic.vert", "basic.frag");
-    glUseProgram(unifiedShader);
-    glUniform1i(glGetUniformLocation(unifiedShader, "uTex"), 0);
+    // Osnovna varijanta (neprozirno, osvetljeno) se prevodi odmah; ostale tek kad ih neko crtanje zatraži
+    SceneShaders sceneShaders;
+    sceneShaders.use(SHADER_VARIANT_OPAQUE_LIT, glState);
 
-    // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ UČITAVANJE .OBJ FAJLA +++++++++++++++++++++++++++++++++++++++++++++++++
+    // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ UČITAVANJE RESURSA +++++++++++++++++++++++++++++++++++++++++++++++++
     
-    std::cout << "Ucitavam .obj fajl..." << std::endl;
-    OBJModel clawMachine = loadOBJ("Resources/claw_machine.obj");
+    // Tekstura potpisa se učitava u pozadini (vidi TextureStreamer.h) i pojavljuje se čim upload završi;
+    // prvi frejmovi se crtaju bez nje
+    TextureStreamer textureStreamer;
+    // Tekstura treba da sadrži "Anja Guzina RA 18/2022" velikim belim slovima (možete zameniti signature.png)
+    TextureHandle signatureHandle = textureStreamer.request("Resources/signature.png");
+    
+    // Modeli i kursori se učitavaju paralelno (vidi AssetLoader.h); GL objekti se prave ovde, na glavnoj niti
+    std::cout << "Ucitavam modele i kursore..." << std::endl;
+    OBJModel clawMachine, claw, bearModel, rabbitModel, ropeModel;
+    // Kursori: coin kad je automat isključen (početak, posle preuzimanja igračke), poluga kad je uključen
+    GLFWcursor* cursorCoin = nullptr;
+    GLFWcursor* cursorLever = nullptr;
+    // Veličina kursora prati skaliranje monitora (32 px pri 100%, 64 px pri 200%...)
+    float contentScaleX, contentScaleY;
+    glfwGetWindowContentScale(window, &contentScaleX, &contentScaleY);
+    int cursorSize = cursorSizeForScale(std::max(contentScaleX, contentScaleY));
+    {
+        AssetLoader loader;
+        loader.addOBJ("Resources/claw_machine.obj", clawMachine);
+        loader.addOBJ("Resources/claw.obj", claw);
+        // Medved i zec (igračke umesto kocke i ptice)
+        loader.addOBJ("Resources/bearobj.obj", bearModel);
+        loader.addOBJ("Resources/rabbit.obj", rabbitModel);
+        // Kanap (corde pendu) – spona između vrha automata i kandže
+        loader.addOBJ("Resources/corde pendu.obj", ropeModel);
+        loader.addCursor("Resources/coin.png", cursorCoin, cursorSize);
+        loader.addCursor("Resources/poluga.png", cursorLever, cursorSize);
+        loader.run();
+    }
+    glfwSetCursor(window, cursorCoin);  // na početku svetlo je ugašeno
+    // Kandža i igračke ostaju iz .obj; ako .glb ne uspe, kućište se crta iz .obj kao inače
+    GLTFModel glbMachine;
+    if (useGLBMachine && !loadGLB("Resources/bird_in_a_claw_machine.glb", glbMachine)) {
+        deleteGLTFModel(glbMachine);
+        useGLBMachine = false;
+    }
     
     if (clawMachine.indexCount == 0) {
         std::cout << "Greska: Model nije uspesno ucitano!" << std::endl;
@@ -653,10 +632,6 @@ int main(void)
     
     std::cout << "Model automata uspesno ucitano!" << std::endl;
     
-    // Učitavanje kandže
-    std::cout << "Ucitavam claw.obj fajl..." << std::endl;
-    OBJModel claw = loadOBJ("Resources/claw.obj");
-    
     if (claw.indexCount == 0) {
         std::cout << "Greska: Claw model nije uspesno ucitano!" << std::endl;
         glfwTerminate();
@@ -665,44 +640,91 @@ int main(void)
     
     std::cout << "Model kandze uspesno ucitano! Broj trouglova: " << claw.indexCount / 3 << std::endl;
     
-    // Učitavanje medveda i zeca (igračke umesto kocke i ptice)
-    OBJModel bearModel = loadOBJ("Resources/bearobj.obj");
-    OBJModel rabbitModel = loadOBJ("Resources/rabbit.obj");
     const float bearScale = 0.03f;   // manje dimenzije
     const float rabbitScale = 0.022f; // zec manji da uho ne viri iz izloga/stakla
 
-    // Učitavanje kanapa (corde pendu) – spona između vrha automata i kandže
-    std::cout << "Ucitavam corde pendu.obj (kanap)..." << std::endl;
-    OBJModel ropeModel = loadOBJ("Resources/corde pendu.obj");
     if (ropeModel.indexCount > 0)
         std::cout << "Kanap ucitan! Broj trouglova: " << ropeModel.indexCount / 3 << std::endl;
     // Konstante za pozicioniranje kanapa: model ima Y od ~-3.8 do ~275; gornji deo kanapa (koji dodiruje automat) mapiramo na vrh
     const float ropeModelHeight = 279.0f;
     const float ropeModelTopY = -3.8f;   // Y u .obj koji treba da dodiruje vrh automata (0.5) – prvi mesh je „gore”
+
+    // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ MATERIJALI +++++++++++++++++++++++++++++++++++++++++++++++++
+
+    // Svi materijali scene idu jednom u MaterialBlock; u petlji se bira samo indeks
+    MaterialUniformBuffer materialBuffer;
+    materialBuffer.addModel(clawMachine);
+    materialBuffer.addModel(claw);
+    materialBuffer.addModel(bearModel);
+    materialBuffer.addModel(rabbitModel);
+    materialBuffer.addModel(ropeModel);
+    if (useGLBMachine)
+        materialBuffer.addModel(glbMachine);
+    // Stanja sijalice (specular isti za sva stanja)
+    const glm::vec3 bulbSpecular(0.6f, 0.7f, 0.9f);
+    const int bulbGreenMaterial = (int)materialBuffer.add(makeMaterialData(
+        glm::vec3(0.35f, 0.5f, 0.35f), glm::vec3(0.6f, 0.9f, 0.6f), bulbSpecular, 64.0f, glm::vec4(0.0f, 1.0f, 0.0f, 1.0f)));
+    const int bulbRedMaterial = (int)materialBuffer.add(makeMaterialData(
+        glm::vec3(0.5f, 0.35f, 0.35f), glm::vec3(0.9f, 0.6f, 0.6f), bulbSpecular, 64.0f, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f)));
+    const int bulbOffMaterial = (int)materialBuffer.add(makeMaterialData(   // tamno plava = automat OFF / svetlo ugašeno
+        glm::vec3(0.2f, 0.3f, 0.5f), glm::vec3(0.3f, 0.4f, 0.6f), bulbSpecular, 64.0f, glm::vec4(0.1f, 0.2f, 0.4f, 1.0f)));
+    const int bulbOnMaterial = (int)materialBuffer.add(makeMaterialData(    // svetlo plava kada je upaljena
+        glm::vec3(0.5f, 0.7f, 1.0f), glm::vec3(0.6f, 0.8f, 1.0f), bulbSpecular, 64.0f, glm::vec4(0.0f, 0.8f, 1.0f, 1.0f)));
+    // Overlay koristi samo boju (tekstura * boja, skoro puna vidljivost)
+    const int overlayMaterial = (int)materialBuffer.add(makeMaterialData(
+        glm::vec3(0.0f), glm::vec3(0.0f), glm::vec3(0.0f), 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.95f)));
+    materialBuffer.upload();
+    std::cout << "Materijala u uniform bloku: " << materialBuffer.size() << std::endl;
+
+    FrameUniformBuffer frameBuffer;
+    frameBuffer.create();
     
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ UNIFORME +++++++++++++++++++++++++++++++++++++++++++++++++
     
     std::cout << "Kreiram uniforme..." << std::endl;
-    unsigned int modelLoc = glGetUniformLocation(unifiedShader, "uM");
-    
     glm::mat4 view;
     glm::vec3 cameraTarget = glm::vec3(0.0f, 0.0f, 0.0f); // Centar scene
     glm::vec3 cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
-    unsigned int viewLoc = glGetUniformLocation(unifiedShader, "uV");
     
     glm::mat4 projectionP = glm::perspective(glm::radians(45.0f), (float)wWidth / (float)wHeight, 0.1f, 100.0f);
-    unsigned int projectionLoc = glGetUniformLocation(unifiedShader, "uP");
     
     // Model matrica za automat
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
     modelMatrix = glm::scale(modelMatrix, glm::vec3(0.1f, 0.1f, 0.1f)); // Povećano skaliranje modela
+    // Važi i za kandžu, koja je samo pomerena u odnosu na automat (translacija ne menja matricu normala)
+    const glm::mat3 modelNormalMatrix = normalMatrix(modelMatrix);
+    const MachineParts machineParts = classifyMachineParts(clawMachine);
+    // Statični delovi automata se crtaju jednim glMultiDrawElementsIndirect po grupi (GL 4.3 / ARB_multi_draw_indirect);
+    // kandža se pomera, pa ostaje na pojedinačnim stavkama
+    MultiDrawBatch machineOpaqueBatch, machineDoubleSidedBatch, machineGlassBatch;
+    if (machineOpaqueBatch.create(clawMachine, machineParts.opaque)) {
+        machineDoubleSidedBatch.create(clawMachine, machineParts.doubleSided);
+        machineGlassBatch.create(clawMachine, machineParts.glass);
+        const unsigned int ranges = machineOpaqueBatch.drawCount() + machineDoubleSidedBatch.drawCount() + machineGlassBatch.drawCount();
+        const int calls = (int)machineOpaqueBatch.valid() + (int)machineDoubleSidedBatch.valid() + (int)machineGlassBatch.valid();
+        std::cout << "Automat se crta preko multi-draw: " << ranges << " opsega u " << calls << " poziva" << std::endl;
+    } else if (!multiDrawIndirectSupported()) {
+        std::cout << "glMultiDrawElementsIndirect nije podrzan, automat se crta po opsezima" << std::endl;
+    }
+    RenderQueue renderQueue;
+
+    // Medved i zec (i igračke stres testa) se crtaju instancirano: jedan poziv po materijalu (vidi InstancedMesh.h)
+    InstancedMesh bearInstances, rabbitInstances;
+    if (bearModel.indexCount > 0) bearInstances.create(bearModel);
+    if (rabbitModel.indexCount > 0) rabbitInstances.create(rabbitModel);
+    std::vector<StressToy> stressToys = makeStressToys(stressToyCount, bearScale, rabbitScale);
+    bool stressInstanced = true;
+    double stressRenderSeconds = 0.0, stressReportTime = glfwGetTime();
+    int stressFrames = 0;
+    if (stressToyCount > 0)
+        std::cout << "Stres test: " << stressToyCount << " igracaka (+/- menja broj, I = instancirano/pojedinacno)" << std::endl;
     
     std::cout << "Uniforme kreirane!" << std::endl;
     
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ RENDER LOOP - PETLJA ZA CRTANJE +++++++++++++++++++++++++++++++++++++++++++++++++
     std::cout << "Postavljam shader i clear color..." << std::endl;
-    glUseProgram(unifiedShader);
+    sceneShaders.use(SHADER_VARIANT_OPAQUE_LIT, glState);
     glClearColor(0.2f, 0.2f, 0.25f, 1.0f);
     std::cout << "Shader i clear color postavljeni!" << std::endl;
 
@@ -746,22 +768,18 @@ int main(void)
        -toyCubeSize, toyCubeSize,-toyCubeSize,   1.0f, 0.7f, 0.8f, 1.0f,   0.0f, 1.0f,    0.0f, 0.0f, -1.0f,
     };
     
+    // Ručno pravljene mreže se pakuju u isti kompaktni format kao .obj modeli (boja iz niza se ne koristi)
+    VertexQuantization toyCubeQuantization;
+    std::vector<PackedVertex> toyCubePacked = packInterleavedVertices(toyCubeVertices, sizeof(toyCubeVertices) / (12 * sizeof(float)), toyCubeQuantization);
+    
     unsigned int toyCubeVAO, toyCubeVBO;
     glGenVertexArrays(1, &toyCubeVAO);
     glBindVertexArray(toyCubeVAO);
     glGenBuffers(1, &toyCubeVBO);
     glBindBuffer(GL_ARRAY_BUFFER, toyCubeVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(toyCubeVertices), toyCubeVertices, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, toyCubePacked.size() * sizeof(PackedVertex), toyCubePacked.data(), GL_STATIC_DRAW);
     
-    unsigned int stride = 12 * sizeof(float);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(7 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(10 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    setPackedVertexAttributes();
     glBindVertexArray(0);
     
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ KREIRANJE SIJALICE +++++++++++++++++++++++++++++++++++++++++++++++++
@@ -820,6 +838,11 @@ int main(void)
         }
     }
     
+    // Sfera ima (segmenti + 1)^2 vertex-a, pa indeksi staju u 16 bita
+    VertexQuantization lightBulbQuantization;
+    std::vector<PackedVertex> lightBulbPacked = packInterleavedVertices(lightBulbVertices.data(), lightBulbVertices.size() / 12, lightBulbQuantization);
+    std::vector<uint16_t> lightBulbShortIndices = narrowIndices(lightBulbIndices.data(), lightBulbIndices.size());
+    
     unsigned int lightBulbVAO, lightBulbVBO, lightBulbEBO;
     glGenVertexArrays(1, &lightBulbVAO);
     glBindVertexArray(lightBulbVAO);
@@ -827,24 +850,16 @@ int main(void)
     glGenBuffers(1, &lightBulbEBO);
     
     glBindBuffer(GL_ARRAY_BUFFER, lightBulbVBO);
-    glBufferData(GL_ARRAY_BUFFER, lightBulbVertices.size() * sizeof(float), lightBulbVertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, lightBulbPacked.size() * sizeof(PackedVertex), lightBulbPacked.data(), GL_STATIC_DRAW);
     
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lightBulbEBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, lightBulbIndices.size() * sizeof(unsigned int), lightBulbIndices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, lightBulbShortIndices.size() * sizeof(uint16_t), lightBulbShortIndices.data(), GL_STATIC_DRAW);
     
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(7 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(10 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    setPackedVertexAttributes();
     glBindVertexArray(0);
     
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ OVERLAY – potpis (ime, prezime, indeks) u uglu +++++++++++++++++++++++++++++++++++++++++++++++++
-    // Tekstura treba da sadrži "Anja Guzina RA 18/2022" velikim belim slovima (možete zameniti signature.png)
-    unsigned int signatureTex = loadImageToTexture("Resources/signature.png");
+    // Tekstura potpisa stiže preko textureStreamer (signatureHandle)
     // Quad u NDC za donji levi ugao: ista širina, samo rastegnuto na gore da se bolje vide slova
     float overlayW = 0.42f, overlayH = 0.32f;   // samo visina povećana (rastegnuto na gore)
     float ox0 = -0.98f, oy0 = -0.94f;  // levo dole
@@ -854,28 +869,23 @@ int main(void)
         ox0+overlayW, oy0+overlayH, 0.0f,  1.0f, 1.0f, 1.0f, 1.0f,  1.0f, 1.0f,  0.0f, 1.0f, 0.0f,
         ox0+overlayW, oy0,         0.0f,  1.0f, 1.0f, 1.0f, 1.0f,  1.0f, 0.0f,  0.0f, 1.0f, 0.0f,
     };
-    unsigned int overlayIndices[] = { 0, 1, 2,  0, 2, 3 };
+    uint16_t overlayIndices[] = { 0, 1, 2,  0, 2, 3 };
+    VertexQuantization overlayQuantization;
+    std::vector<PackedVertex> overlayPacked = packInterleavedVertices(overlayVerts, 4, overlayQuantization);
     unsigned int overlayVAO, overlayVBO, overlayEBO;
     glGenVertexArrays(1, &overlayVAO);
     glGenBuffers(1, &overlayVBO);
     glGenBuffers(1, &overlayEBO);
     glBindVertexArray(overlayVAO);
     glBindBuffer(GL_ARRAY_BUFFER, overlayVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(overlayVerts), overlayVerts, GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, overlayPacked.size() * sizeof(PackedVertex), overlayPacked.data(), GL_STATIC_DRAW);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, overlayEBO);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(overlayIndices), overlayIndices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(7 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)(10 * sizeof(float)));
-    glEnableVertexAttribArray(3);
+    setPackedVertexAttributes();
     glBindVertexArray(0);
     
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++ RENDER LOOP - PETLJA ZA CRTANJE +++++++++++++++++++++++++++++++++++++++++++++++++
-    glUseProgram(unifiedShader);
+    sceneShaders.use(SHADER_VARIANT_OPAQUE_LIT, glState);
     glClearColor(0.2f, 0.2f, 0.25f, 1.0f);
     
     if (clawMachine.indexCount == 0) {
@@ -903,6 +913,9 @@ int main(void)
         float dt = (float)(currentTime - lastFrameTime);
         lastFrameTime = currentTime;
 
+        // Teksture koje su se dekodirale u pozadini idu na GPU bez čekanja
+        textureStreamer.update();
+
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         {
             glfwSetWindowShouldClose(window, GL_TRUE);
@@ -944,6 +957,29 @@ int main(void)
         {
             lKeyPressed = false;
         }
+
+        // Stres test: + / - duplira / polovi broj igračaka, I prebacuje instancirano / pojedinačno crtanje
+        if (stressToyCount > 0)
+        {
+            static bool plusPressed = false, minusPressed = false, iPressed = false;
+            const bool plus = glfwGetKey(window, GLFW_KEY_EQUAL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_KP_ADD) == GLFW_PRESS;
+            const bool minus = glfwGetKey(window, GLFW_KEY_MINUS) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_KP_SUBTRACT) == GLFW_PRESS;
+            const bool toggle = glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS;
+            if ((plus && !plusPressed) || (minus && !minusPressed)) {
+                stressToyCount = plus ? stressToyCount * 2 : std::max(1, stressToyCount / 2);
+                stressToys = makeStressToys(stressToyCount, bearScale, rabbitScale);
+                stressFrames = 0;
+                stressRenderSeconds = 0.0;
+            }
+            if (toggle && !iPressed) {
+                stressInstanced = !stressInstanced;
+                stressFrames = 0;
+                stressRenderSeconds = 0.0;
+            }
+            plusPressed = plus;
+            minusPressed = minus;
+            iPressed = toggle;
+        }
         
         // Kontrole za kandžu – samo kad je kamera ispred automata (yaw normalizovan da pun krug radi)
         float yawNorm = cameraYaw;
@@ -1062,189 +1098,67 @@ int main(void)
 
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         
-        glUseProgram(unifiedShader);
-        glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(projectionP));
-
-        // Osvetljenje – lampa (sijalica) je izvor svetlosti, uz ambijentalno svetlo
+        // Kamera i osvetljenje – lampa (sijalica) je izvor svetlosti, uz ambijentalno svetlo; jedan upload po frejmu
         glm::vec3 lightPos(0.0f, 0.5f, 0.0f);  // ista pozicija kao sijalica na vrhu automata
         glm::vec3 viewPos = cameraPos; // Koristimo trenutnu poziciju kamere
         glm::vec3 lightColor(1.0f, 1.0f, 1.0f);
-        glUniform3f(glGetUniformLocation(unifiedShader, "uLightPos"), lightPos.x, lightPos.y, lightPos.z);
-        glUniform3f(glGetUniformLocation(unifiedShader, "uViewPos"), viewPos.x, viewPos.y, viewPos.z);
-        glUniform3f(glGetUniformLocation(unifiedShader, "uLightColor"), lightColor.r, lightColor.g, lightColor.b);
-        
-        // Materijal
-        glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.3f, 0.3f, 0.3f);
-        glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.8f, 0.8f, 0.8f);
-        glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), 0.5f, 0.5f, 0.5f);
-        glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), 64.0f);
+        FrameData frame;
+        frame.view = view;
+        frame.projection = projectionP;
+        frame.lightPos = glm::vec4(lightPos, 1.0f);
+        frame.viewPos = glm::vec4(viewPos, 1.0f);
+        frame.lightColor = glm::vec4(lightColor, 1.0f);
+        frameBuffer.update(frame);
         
-        // PRVO RENDERUJEMO NEprozirne objekte PRE automata
+        // Svi objekti predaju stavke u red; redosled crtanja određuje ključ (vidi RenderQueue.h)
+        const double renderStart = glfwGetTime();
+        glState.beginFrame();
+        renderQueue.begin(cameraPos);
+        bearInstances.clear();
+        rabbitInstances.clear();
         
-        // 1. Renderovanje sijalice na vrhu automata - PRVO
+        // Sijalica na vrhu automata
         glm::mat4 lightBulbMatrix = glm::mat4(1.0f);
         lightBulbMatrix = glm::translate(lightBulbMatrix, glm::vec3(0.0f, 0.5f, 0.0f)); // Na vrhu automata (u world space) - još više na vrhu
         lightBulbMatrix = glm::scale(lightBulbMatrix, glm::vec3(0.5f, 0.5f, 0.5f)); // Još povećano skaliranje da bude vidljivija
-        
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(lightBulbMatrix));
-        glUniform1i(glGetUniformLocation(unifiedShader, "transparent"), 0);
-        glUniform1i(glGetUniformLocation(unifiedShader, "useTex"), 0);
-        
-        // Boja sijalice: zeleno-crveno trepćuće – isti 3D senčenje kao plava/tamno plava (sféra, ne ravna tekstura)
-        if (prizeBlinking)
         {
-            if (blinkGreen) {
-                glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 0.0f, 1.0f, 0.0f, 1.0f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.35f, 0.5f, 0.35f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.6f, 0.9f, 0.6f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), 0.5f, 0.6f, 0.5f);
-                glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), 48.0f);
-            } else {
-                glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 1.0f, 0.0f, 0.0f, 1.0f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.5f, 0.35f, 0.35f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.9f, 0.6f, 0.6f);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), 0.6f, 0.5f, 0.5f);
-                glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), 48.0f);
-            }
-        }
-        else if (!machineOn)
-        {
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 0.1f, 0.2f, 0.4f, 1.0f); // Tamno plava = automat OFF
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.2f, 0.3f, 0.5f);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.3f, 0.4f, 0.6f);
-        }
-        else if (lightOn)
-        {
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 0.0f, 0.8f, 1.0f, 1.0f); // Svetlo plava kada je upaljena
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.5f, 0.7f, 1.0f);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.6f, 0.8f, 1.0f);
-        }
-        else
-        {
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 0.1f, 0.2f, 0.4f, 1.0f);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), 0.2f, 0.3f, 0.5f);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), 0.3f, 0.4f, 0.6f);
-        }
-        // Material specular ostaje isti za oba stanja
-        glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), 0.6f, 0.7f, 0.9f);
-        glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), 64.0f);
-        
-        glBindVertexArray(lightBulbVAO);
-        glDrawElements(GL_TRIANGLES, (unsigned int)lightBulbIndices.size(), GL_UNSIGNED_INT, (void*)0);
-        glBindVertexArray(0);
-        
-        // ZATIM RENDERUJEMO .obj model automata - PRVO NEPROZIRNI DELOVI (medved i zec se crtaju POSLE da ne budu zaklonjeni)
-        // Resetujemo OpenGL stanja pre renderovanja automata (poštujemo tastere 1–4 za dubinu i culling)
-        if (depthTestEnabled) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        if (cullFaceEnabled) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-        
-        glUniform1i(glGetUniformLocation(unifiedShader, "useTex"), 0); // Ne koristimo teksturu za .obj model
-        
-        glBindVertexArray(clawMachine.VAO);
-        
-        // Grupiši indekse po materijalima - kreiraj mapu (matID -> lista (startIndex, count))
-        std::map<unsigned int, std::vector<std::pair<size_t, size_t>>> materialRanges;
-        unsigned int currentMatID = (clawMachine.materialIndices.size() > 0) ? clawMachine.materialIndices[0] : 0;
-        size_t rangeStart = 0;
-        
-        for (size_t i = 0; i < clawMachine.indices.size(); ++i) {
-            unsigned int matID = (i < clawMachine.materialIndices.size()) ? clawMachine.materialIndices[i] : 0;
-            
-            if (matID != currentMatID) {
-                // Završi prethodni range
-                if (i > rangeStart) {
-                    materialRanges[currentMatID].push_back(std::make_pair(rangeStart, i - rangeStart));
-                }
-                // Počni novi range
-                currentMatID = matID;
-                rangeStart = i;
-            }
-        }
-        // Završi poslednji range
-        if (clawMachine.indices.size() > rangeStart) {
-            materialRanges[currentMatID].push_back(std::make_pair(rangeStart, clawMachine.indices.size() - rangeStart));
-        }
-        
-        // Pronađi materijal po ID - kreiraj mapu ID -> ime
-        std::map<unsigned int, std::string> matIDToName;
-        unsigned int id = 0;
-        for (const auto& pair : clawMachine.materials) {
-            matIDToName[id++] = pair.first;
+            DrawItem bulb;
+            bulb.program = SHADER_VARIANT_OPAQUE_LIT;
+            bulb.transform = renderQueue.addTransform(lightBulbMatrix);
+            bulb.vao = lightBulbVAO;
+            bulb.indexType = GL_UNSIGNED_SHORT;
+            bulb.indexSize = sizeof(uint16_t);
+            bulb.count = (unsigned int)lightBulbShortIndices.size();
+            bulb.quantization = &lightBulbQuantization;
+            // Boja sijalice: zeleno-crveno trepćuće – isti 3D senčenje kao plava/tamno plava (sféra, ne ravna tekstura)
+            if (prizeBlinking)
+                bulb.material = blinkGreen ? bulbGreenMaterial : bulbRedMaterial;
+            else if (machineOn && lightOn)
+                bulb.material = bulbOnMaterial;
+            else
+                bulb.material = bulbOffMaterial;
+            renderQueue.submit(bulb);
         }
         
-        // PRVO RENDERUJEMO NEPROZIRNE DELOVE AUTOMATA
-        for (const auto& group : materialRanges) {
-            unsigned int matID = group.first;
-            const std::vector<std::pair<size_t, size_t>>& ranges = group.second;
-            
-            // Pronađi materijal
-            Material* mat = nullptr;
-            if (matIDToName.find(matID) != matIDToName.end()) {
-                std::string matName = matIDToName[matID];
-                if (clawMachine.materials.find(matName) != clawMachine.materials.end()) {
-                    mat = &clawMachine.materials[matName];
-                }
-            }
-            
-            // Ako nema materijala, koristi default
-            if (!mat && !clawMachine.materials.empty()) {
-                mat = &clawMachine.materials.begin()->second;
-            }
-            
-            if (!mat) continue;
-            
-            // Preskoči transparentne delove - renderujemo ih posle kandže
-            if (mat->d < 1.0f) continue;
-            
-            std::string matName = (matIDToName.find(matID) != matIDToName.end()) ? matIDToName[matID] : "";
-            if (matName == "pink_frame") continue;
-            if (matName == "black") continue;
-            if (matName == "bird" || matName == "bird_red") continue;  // pticu ne crtamo uopšte
-            if (matName == "pink") continue;  // kandžu crtamo POSLE igračke u kandži da ne bledi
-            
-            // Ostali delovi koriste modelMatrix
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-            // Dno automata - skin materijal kao u popravka.obj (opaque sivo)
-            if (matName == "skin" || matName == "floor_metal") {
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), mat->Ka.r, mat->Ka.g, mat->Ka.b);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), mat->Kd.r, mat->Kd.g, mat->Kd.b);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), mat->Ks.r, mat->Ks.g, mat->Ks.b);
-                glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), mat->Ns);
-                glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), mat->Kd.r, mat->Kd.g, mat->Kd.b, 1.0f);
-                glDisable(GL_CULL_FACE);  // crtaj obe strane da se dno uvek vidi
-            } else {
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), mat->Ka.r, mat->Ka.g, mat->Ka.b);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), mat->Kd.r, mat->Kd.g, mat->Kd.b);
-                glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), mat->Ks.r, mat->Ks.g, mat->Ks.b);
-                glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), mat->Ns);
-                glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), mat->Kd.r, mat->Kd.g, mat->Kd.b, mat->d);
-                if (cullFaceEnabled) glEnable(GL_CULL_FACE);
-            }
-            glUniform1i(glGetUniformLocation(unifiedShader, "transparent"), 0);
-            
-            // Renderuj sve range-ove za ovaj materijal
-            for (const auto& range : ranges) {
-                size_t startIdx = range.first;
-                size_t count = range.second;
-                glDrawElements(GL_TRIANGLES, (unsigned int)count, GL_UNSIGNED_INT, (void*)(startIdx * sizeof(unsigned int)));
-            }
-            if (matName == "skin" || matName == "floor_metal")
-                if (cullFaceEnabled) glEnable(GL_CULL_FACE);  // vrati culling za sledeći materijal
+        // Automat: neprozirni delovi, dno sa obe strane i staklo (staklo u providnom prolazu, da se kandža vidi kroz njega)
+        if (useGLBMachine) {
+            submitGLTFMachine(renderQueue, glbMachine, modelMatrix);
+        } else {
+            const uint32_t machineTransform = renderQueue.addTransform(modelMatrix, modelNormalMatrix);
+            submitMachineRanges(renderQueue, clawMachine, machineParts.opaque, machineOpaqueBatch, machineTransform, RENDER_PASS_OPAQUE);
+            submitMachineRanges(renderQueue, clawMachine, machineParts.doubleSided, machineDoubleSidedBatch, machineTransform, RENDER_PASS_OPAQUE,
+                                RENDER_STATE_DOUBLE_SIDED);
+            submitMachineRanges(renderQueue, clawMachine, machineParts.glass, machineGlassBatch, machineTransform, RENDER_PASS_TRANSPARENT);
         }
         
-        glBindVertexArray(0);
-        
         // Medved (prva igračka) – crtamo osim kad je u kandži ili kad je pokupljen (nestane)
-        if (carriedWhich != 1 && bearModel.indexCount > 0 && !(toyWon && toyCollected))
+        if (carriedWhich != 1 && !(toyWon && toyCollected))
         {
             float scale = toyWon ? (bearScale * prizeInCompartmentScale) : bearScale;  // u pregradi manje da ne strči kroz metal
             glm::mat4 bearMatrix = glm::mat4(1.0f);
             bearMatrix = glm::translate(bearMatrix, glm::vec3(toyCubeX, toyCubeY, toyCubeZ));
             bearMatrix = glm::scale(bearMatrix, glm::vec3(scale, scale, scale));
-            drawOBJModel(bearModel, bearMatrix, modelLoc, unifiedShader);
+            bearInstances.add(bearMatrix);
         }
         
         // Igračka u kandži – medved ili zec na poziciji kandže
@@ -1253,18 +1167,18 @@ int main(void)
             float cwx = machineScale * clawX, cwy = machineScale * (clawY - clawTipOffset), cwz = machineScale * clawZ;
             glm::mat4 carriedMatrix = glm::mat4(1.0f);
             carriedMatrix = glm::translate(carriedMatrix, glm::vec3(cwx, cwy, cwz));
-            if (carriedWhich == 1 && bearModel.indexCount > 0) {
+            if (carriedWhich == 1) {
                 carriedMatrix = glm::scale(carriedMatrix, glm::vec3(bearScale, bearScale, bearScale));
-                drawOBJModel(bearModel, carriedMatrix, modelLoc, unifiedShader);
-            } else if (carriedWhich == 2 && rabbitModel.indexCount > 0) {
+                bearInstances.add(carriedMatrix);
+            } else {
                 carriedMatrix = glm::rotate(carriedMatrix, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
                 carriedMatrix = glm::scale(carriedMatrix, glm::vec3(rabbitScale, rabbitScale, rabbitScale));
-                drawOBJModel(rabbitModel, carriedMatrix, modelLoc, unifiedShader);
+                rabbitInstances.add(carriedMatrix);
             }
         }
         
         // Kanap (corde pendu) – vrh kanapa na vrhu automata (0.5), dno na VRHU SIPKE; podignut nagore po Y da se vidi
-        if (clawY < 0.5f && ropeModel.indexCount > 0) {
+        if (clawY < 0.5f) {
             const float ropeLiftY = 2.2f;   // pomeranje kanapa nagore po Y osi
             const float ropeForwardZ = 0.04f;  // kanap malo napred po Z da se nadoveže na sipku (ne ispred/iza)
             float ropeBottomY = clawY + sipkaTopOffset;
@@ -1275,146 +1189,81 @@ int main(void)
                 float ropeScaleXZ = 0.045f;
                 glm::mat4 ropeMatrix = glm::translate(modelMatrix, glm::vec3(clawX, transY, clawZ + ropeForwardZ));
                 ropeMatrix = glm::scale(ropeMatrix, glm::vec3(ropeScaleXZ, scaleY, ropeScaleXZ));
-                drawOBJModel(ropeModel, ropeMatrix, modelLoc, unifiedShader);
+                submitOBJModel(renderQueue, ropeModel, ropeMatrix);
             }
         }
 
-        // Kandža (pink) – crtamo POSLE igračaka sa depth offset-om kada drži igračku (da ne bledi)
-        // Kandža: jači offset kad nosi medveda (širi model) da ne bledi, slabiji za zeca
-        if (carriedWhich == 1 || carriedWhich == 2) {
-            glEnable(GL_POLYGON_OFFSET_FILL);
-            if (carriedWhich == 1)
-                glPolygonOffset(-2.5f, -2.5f);  // medved širi – kandža više „ispred” da se ne gubi
-            else
-                glPolygonOffset(-1.0f, -1.0f);  // zec uži – manji offset dovoljan
-        }
-        glBindVertexArray(clawMachine.VAO);
-        for (const auto& group : materialRanges) {
-            unsigned int matID = group.first;
-            const std::vector<std::pair<size_t, size_t>>& ranges = group.second;
-            Material* mat = nullptr;
-            if (matIDToName.find(matID) != matIDToName.end()) {
-                std::string matName = matIDToName[matID];
-                if (clawMachine.materials.find(matName) != clawMachine.materials.end()) {
-                    mat = &clawMachine.materials[matName];
-                }
-            }
-            if (!mat || mat->d < 1.0f) continue;
-            std::string matName = (matIDToName.find(matID) != matIDToName.end()) ? matIDToName[matID] : "";
-            if (matName != "pink") continue;  // samo kandža
-            
-            glm::mat4 pinkMatrix = glm::translate(modelMatrix, glm::vec3(clawX, clawY, clawZ));
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(pinkMatrix));
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), mat->Ka.r, mat->Ka.g, mat->Ka.b);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), mat->Kd.r, mat->Kd.g, mat->Kd.b);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), mat->Ks.r, mat->Ks.g, mat->Ks.b);
-            glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), mat->Ns);
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), mat->Kd.r, mat->Kd.g, mat->Kd.b, mat->d);
-            glUniform1i(glGetUniformLocation(unifiedShader, "transparent"), 0);
-            if (cullFaceEnabled) glEnable(GL_CULL_FACE);
-            
-            for (const auto& range : ranges) {
-                size_t startIdx = range.first;
-                size_t count = range.second;
-                glDrawElements(GL_TRIANGLES, (unsigned int)count, GL_UNSIGNED_INT, (void*)(startIdx * sizeof(unsigned int)));
-            }
-        }
-        glBindVertexArray(0);
-        if (carriedWhich == 1 || carriedWhich == 2) {
-            glDisable(GL_POLYGON_OFFSET_FILL);
-        }
+        // Kandža (pink) – kada drži igračku crta se posle neprozirnih sa depth offset-om (da ne bledi);
+        // jači offset kad nosi medveda (širi model), slabiji za zeca. Translacija ne menja matricu normala.
+        const bool clawCarries = carriedWhich == 1 || carriedWhich == 2;
+        const uint32_t clawTransform = renderQueue.addTransform(glm::translate(modelMatrix, glm::vec3(clawX, clawY, clawZ)), modelNormalMatrix);
+        submitRanges(renderQueue, clawMachine, machineParts.claw, clawTransform,
+                     clawCarries ? RENDER_PASS_OPAQUE_OFFSET : RENDER_PASS_OPAQUE, SHADER_VARIANT_OPAQUE_LIT);
         
         // Zec (druga igračka) – crtamo osim kad je u kandži ili kad je pokupljen (nestane)
-        if (carriedWhich != 2 && rabbitModel.indexCount > 0 && !(birdWon && birdCollected))
+        if (carriedWhich != 2 && !(birdWon && birdCollected))
         {
             float scale = birdWon ? (rabbitScale * prizeInCompartmentScale) : rabbitScale;  // u pregradi manje da uvo ne strči kroz metal
             glm::mat4 rabbitMatrix = glm::mat4(1.0f);
             rabbitMatrix = glm::translate(rabbitMatrix, glm::vec3(birdToyX, birdToyY, birdToyZ));
             rabbitMatrix = glm::rotate(rabbitMatrix, glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
             rabbitMatrix = glm::scale(rabbitMatrix, glm::vec3(scale, scale, scale));
-            drawOBJModel(rabbitModel, rabbitMatrix, modelLoc, unifiedShader);
+            rabbitInstances.add(rabbitMatrix);
         }
-        
-        // NA KRAJU RENDERUJEMO TRANSPARENTNE DELOVE AUTOMATA (staklo) - da se kandža vidi kroz njih
-        if (depthTestEnabled) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glDisable(GL_CULL_FACE); // Isključeno za transparent objekte
-        
-        glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(modelMatrix));
-        glUniform1i(glGetUniformLocation(unifiedShader, "useTex"), 0);
-        
-        glBindVertexArray(clawMachine.VAO);
-        
-        // Renderuj samo transparentne delove automata (staklo)
-        for (const auto& group : materialRanges) {
-            unsigned int matID = group.first;
-            const std::vector<std::pair<size_t, size_t>>& ranges = group.second;
-            
-            // Pronađi materijal
-            Material* mat = nullptr;
-            if (matIDToName.find(matID) != matIDToName.end()) {
-                std::string matName = matIDToName[matID];
-                if (clawMachine.materials.find(matName) != clawMachine.materials.end()) {
-                    mat = &clawMachine.materials[matName];
-                }
-            }
-            
-            if (!mat && !clawMachine.materials.empty()) {
-                mat = &clawMachine.materials.begin()->second;
-            }
-            
-            if (!mat) continue;
-            
-            // Renderuj samo transparentne delove
-            if (mat->d >= 1.0f) continue;
-            
-            // Postavi materijal uniforme
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialAmbient"), mat->Ka.r, mat->Ka.g, mat->Ka.b);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialDiffuse"), mat->Kd.r, mat->Kd.g, mat->Kd.b);
-            glUniform3f(glGetUniformLocation(unifiedShader, "uMaterialSpecular"), mat->Ks.r, mat->Ks.g, mat->Ks.b);
-            glUniform1f(glGetUniformLocation(unifiedShader, "uMaterialShininess"), mat->Ns);
-            
-            // Postavi boju i transparentnost
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), mat->Kd.r, mat->Kd.g, mat->Kd.b, mat->d);
-            glUniform1i(glGetUniformLocation(unifiedShader, "transparent"), 1);
-            glDisable(GL_CULL_FACE);
-            
-            // Renderuj sve range-ove za ovaj materijal
-            for (const auto& range : ranges) {
-                size_t startIdx = range.first;
-                size_t count = range.second;
-                glDrawElements(GL_TRIANGLES, (unsigned int)count, GL_UNSIGNED_INT, (void*)(startIdx * sizeof(unsigned int)));
-            }
+
+        // Igračke stres testa; pojedinačno crtanje (za poređenje) ide bez boje instance
+        for (const StressToy& toy : stressToys) {
+            if (stressInstanced)
+                (toy.rabbit ? rabbitInstances : bearInstances).add(toy.matrix, toy.tint);
+            else
+                submitOBJModel(renderQueue, toy.rabbit ? rabbitModel : bearModel, toy.matrix);
         }
+        const uint32_t instancedTransform = renderQueue.addTransform(glm::mat4(1.0f));
+        submitInstancedMesh(renderQueue, bearInstances, instancedTransform);
+        submitInstancedMesh(renderQueue, rabbitInstances, instancedTransform);
         
-        glBindVertexArray(0);
+        // Overlay – poluprovidna tekstura sa imenom, prezimenom i indeksom (donji levi ugao), kad stigne.
+        // Overlay varijanta: uM vodi direktno u clip prostor (FrameBlock ostaje netaknut), bez osvetljenja –
+        // tekstura direktno, slova oštra
+        unsigned int signatureTex = textureStreamer.texture(signatureHandle);
+        if (signatureTex)
+        {
+            DrawItem overlay;
+            overlay.pass = RENDER_PASS_OVERLAY;
+            overlay.program = SHADER_VARIANT_UNLIT_OVERLAY;
+            overlay.transform = renderQueue.addTransform(glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f));
+            overlay.vao = overlayVAO;
+            overlay.indexType = GL_UNSIGNED_SHORT;
+            overlay.indexSize = sizeof(uint16_t);
+            overlay.count = 6;
+            overlay.quantization = &overlayQuantization;
+            overlay.material = overlayMaterial;
+            overlay.texture = signatureTex;
+            renderQueue.submit(overlay);
+        }
         
-        // Overlay – poluprovidna tekstura sa imenom, prezimenom i indeksom (donji levi ugao)
+        renderQueue.sort();
+        RenderSettings renderSettings;
+        renderSettings.depthTest = depthTestEnabled;
+        renderSettings.cullFace = cullFaceEnabled;
+        renderSettings.polygonOffset = carriedWhich == 1 ? -2.5f : -1.0f;  // medved širi – kandža više „ispred” da se ne gubi
+        executeRenderQueue(renderQueue, sceneShaders, glState, renderSettings);
+
+        // Stres test: vreme od predaje do završetka crtanja na GPU (glFinish), prosek na svake 2 s
+        if (stressToyCount > 0)
         {
-            glm::mat4 savedProj = projectionP;
-            glm::mat4 savedView = view;
-            glm::mat4 orthoProj = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-            glm::mat4 identityView = glm::mat4(1.0f);
-            glm::mat4 identityModel = glm::mat4(1.0f);
-            glDisable(GL_DEPTH_TEST);
-            glUseProgram(unifiedShader);
-            glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(orthoProj));
-            glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(identityView));
-            glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(identityModel));
-            glUniform1i(glGetUniformLocation(unifiedShader, "useTex"), 1);
-            glUniform1i(glGetUniformLocation(unifiedShader, "overlayMode"), 1);  // bez osvetljenja – tekstura direktno, slova oštra
-            glUniform1i(glGetUniformLocation(unifiedShader, "transparent"), 0);
-            glUniform4f(glGetUniformLocation(unifiedShader, "uColor"), 1.0f, 1.0f, 1.0f, 0.95f);  // skoro puna vidljivost
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, signatureTex);
-            glBindVertexArray(overlayVAO);
-            glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-            glBindVertexArray(0);
-            if (depthTestEnabled) glEnable(GL_DEPTH_TEST);
-            glUniform1i(glGetUniformLocation(unifiedShader, "overlayMode"), 0);  // vrati za 3D scenu
-            glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(savedProj));
-            glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(savedView));
+            glFinish();
+            stressRenderSeconds += glfwGetTime() - renderStart;
+            ++stressFrames;
+            if (glfwGetTime() - stressReportTime >= 2.0) {
+                std::cout << "Stres: " << stressToyCount << " igracaka, " << (stressInstanced ? "instancirano" : "pojedinacno")
+                          << ": " << stressRenderSeconds / stressFrames * 1000.0 << " ms/frejm, "
+                          << renderQueue.size() << " poziva crtanja, " << glState.frameTransitions() << " promena GL stanja ("
+                          << glState.frameSkipped() << " preskoceno)" << std::endl;
+                stressReportTime = glfwGetTime();
+                stressRenderSeconds = 0.0;
+                stressFrames = 0;
+            }
         }
         
         glfwSwapBuffers(window);
@@ -1439,6 +1288,7 @@ int main(void)
     glDeleteBuffers(1, &clawMachine.EBO);
     glDeleteBuffers(1, &clawMachine.VBO);
     glDeleteVertexArrays(1, &clawMachine.VAO);
+    deleteGLTFModel(glbMachine);
     
     // Cleanup za kandžu
     glDeleteBuffers(1, &claw.EBO);
@@ -1473,9 +1323,24 @@ int main(void)
     glDeleteBuffers(1, &overlayEBO);
     glDeleteBuffers(1, &overlayVBO);
     glDeleteVertexArrays(1, &overlayVAO);
-    glDeleteTextures(1, &signatureTex);
-    
-    glDeleteProgram(unifiedShader);
+    textureStreamer.printReport();
+    textureStreamer.release(signatureHandle);
+    textureStreamer.shutdown();  // briše i teksture koje su još u letu
+    bearInstances.destroy();
+    rabbitInstances.destroy();
+    machineOpaqueBatch.destroy();
+    machineDoubleSidedBatch.destroy();
+    machineGlassBatch.destroy();
+    
+    std::cout << "Sejder varijanti prevedeno: " << sceneShaders.variants.loadedCount() << "/" << SHADER_VARIANT_COUNT << std::endl;
+    std::cout << "Uniforme: " << sceneShaders.variants.uploadCount() << " poslato, " << sceneShaders.variants.skippedCount()
+              << " preskoceno (vrednost se nije promenila)" << std::endl;
+    if (glState.frameCount() > 0)
+        std::cout << "GL stanje: " << glState.totalTransitions() / glState.frameCount() << " promena po frejmu, "
+                  << glState.totalSkipped() / glState.frameCount() << " preskoceno (vrednost se nije promenila)" << std::endl;
+    sceneShaders.variants.destroy();
+    frameBuffer.destroy();
+    materialBuffer.destroy();
 
     glfwDestroyCursor(cursorCoin);
     glfwDestroyCursor(cursorLever);
@@ -0,0 +1,193 @@
+#include "../Header/MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Prazan fajl se ne može mapirati, pa za njega vraćamo pokazivač na prazan niz
+static const char emptyFileData[1] = { 0 };
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    moveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::moveFrom(MappedFile& other) {
+    bytes = other.bytes;
+    length = other.length;
+    opened = other.opened;
+    other.bytes = nullptr;
+    other.length = 0;
+    other.opened = false;
+#ifdef _WIN32
+    fileHandle = other.fileHandle;
+    mappingHandle = other.mappingHandle;
+    other.fileHandle = nullptr;
+    other.mappingHandle = nullptr;
+#endif
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const char* path) {
+    close();
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    if (fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        bytes = emptyFileData;
+        opened = true;
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = (const char*)view;
+    length = (size_t)fileSize.QuadPart;
+    opened = true;
+    return true;
+}
+
+void MappedFile::releasePages(size_t offset, size_t count) const {
+    if (!bytes || bytes == emptyFileData || offset >= length)
+        return;
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    size_t pageSize = info.dwPageSize;
+    size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+    size_t last = std::min(offset + count, length) / pageSize * pageSize;
+    // VirtualUnlock na stranicama koje nisu zaključane ih uklanja iz radnog skupa
+    if (last > first)
+        VirtualUnlock((void*)(bytes + first), last - first);
+}
+
+void MappedFile::close() {
+    if (bytes && bytes != emptyFileData)
+        UnmapViewOfFile(bytes);
+    if (mappingHandle)
+        CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle)
+        CloseHandle((HANDLE)fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        bytes = emptyFileData;
+        opened = true;
+        return true;
+    }
+
+    void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // mapiranje ostaje važeće i posle zatvaranja deskriptora
+    if (view == MAP_FAILED)
+        return false;
+    madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    bytes = (const char*)view;
+    length = (size_t)st.st_size;
+    opened = true;
+    return true;
+}
+
+void MappedFile::releasePages(size_t offset, size_t count) const {
+    if (!bytes || bytes == emptyFileData || offset >= length)
+        return;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t first = (offset + pageSize - 1) / pageSize * pageSize;
+    size_t last = std::min(offset + count, length) / pageSize * pageSize;
+    if (last > first)
+        madvise((void*)(bytes + first), last - first, MADV_DONTNEED);
+}
+
+void MappedFile::close() {
+    if (bytes && bytes != emptyFileData)
+        munmap((void*)bytes, length);
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
+
+bool writeFileAtomically(const char* path, const void* header, size_t headerSize, const void* payload, size_t payloadSize) {
+    std::string tmpPath = std::string(path) + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+        out.write((const char*)header, headerSize);
+        if (payloadSize > 0)
+            out.write((const char*)payload, payloadSize);
+        if (!out.good()) {
+            out.close();
+            std::remove(tmpPath.c_str());
+            return false;
+        }
+    }
+    std::remove(path);
+    if (std::rename(tmpPath.c_str(), path) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
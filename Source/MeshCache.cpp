@@ -0,0 +1,221 @@
+#include "../Header/MeshCache.h"
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+
+#include <iostream>
+#include <cstring>
+
+// Raspored keš fajla (sve sekcije poravnate na 4 bajta):
+//   MeshCacheHeader
+//   putanja .mtl fajla (mtlPathLength bajtova)
+//   materijali: za svaki [uint32 dužina imena][ime][11 float-ova: Kd, Ka, Ks, Ns, d]
+//   opsezi materijala: MeshCacheRange[rangeCount] (po jedan za svaki materijal, indeksi sortirani po materijalu)
+//   vertex-i: PackedVertex[vertexCount]
+//   indeksi: uint16 ili uint32 [indexCount], po indexSize
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t objHash;
+    uint64_t mtlHash;
+    uint32_t mtlPathLength;
+    uint32_t materialCount;
+    uint32_t rangeCount;
+    uint32_t vertexStride;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexSize;
+    uint32_t flags;
+    float posScale[3];
+    float posBias[3];
+    uint64_t materialsOffset;
+    uint64_t rangesOffset;
+    uint64_t verticesOffset;
+    uint64_t indicesOffset;
+};
+
+struct MeshCacheRange {
+    uint32_t first;
+    uint32_t count;
+    uint32_t materialID;
+};
+
+static const char meshCacheMagic[4] = { 'K', 'M', 'S', 'H' };
+
+static uint64_t alignTo4(uint64_t offset) {
+    return (offset + 3) & ~(uint64_t)3;
+}
+
+// Da li [offset, offset + bytes) staje u fajl, bez prekoračenja pri sabiranju
+static bool fitsInFile(uint64_t offset, uint64_t bytes, uint64_t size) {
+    return offset <= size && bytes <= size - offset;
+}
+
+std::string meshCachePath(const char* objPath) {
+    return std::string(objPath) + ".meshcache";
+}
+
+bool readMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, OBJModel& model, OBJUploadData& upload) {
+    MappedFile cache;
+    if (!cache.open(meshCachePath(objPath).c_str()))
+        return false;
+
+    const char* base = cache.data();
+    const uint64_t size = cache.size();
+    if (size < sizeof(MeshCacheHeader))
+        return false;
+
+    MeshCacheHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, meshCacheMagic, 4) != 0 || header.version != MESH_CACHE_VERSION ||
+        header.objHash != objHash || header.vertexStride != sizeof(PackedVertex) || header.flags != flags) {
+        std::cout << "Kes modela je zastareo: " << objPath << std::endl;
+        return false;
+    }
+
+    // Provera da sve sekcije staju u fajl pre nego što išta čitamo
+    const uint64_t verticesBytes = (uint64_t)header.vertexCount * sizeof(PackedVertex);
+    const uint64_t indicesBytes = (uint64_t)header.indexCount * header.indexSize;
+    const uint64_t rangesBytes = (uint64_t)header.rangeCount * sizeof(MeshCacheRange);
+    if (!fitsInFile(sizeof(MeshCacheHeader), header.mtlPathLength, size) ||
+        header.materialsOffset < sizeof(MeshCacheHeader) + header.mtlPathLength ||
+        header.materialsOffset > header.rangesOffset ||
+        !fitsInFile(header.rangesOffset, rangesBytes, size) ||
+        !fitsInFile(header.verticesOffset, verticesBytes, size) ||
+        !fitsInFile(header.indicesOffset, indicesBytes, size) ||
+        header.vertexCount == 0 || header.indexCount == 0 || (header.indexSize != 2 && header.indexSize != 4)) {
+        std::cout << "Kes modela je ostecen: " << objPath << std::endl;
+        return false;
+    }
+
+    std::string mtlPath(base + sizeof(MeshCacheHeader), header.mtlPathLength);
+    if (hashFile(mtlPath) != header.mtlHash) {
+        std::cout << "Kes modela je zastareo (.mtl promenjen): " << objPath << std::endl;
+        return false;
+    }
+
+    // Tabela materijala (redom po slotu)
+    std::vector<Material> materials;
+    std::vector<std::string> materialNames;
+    uint64_t offset = header.materialsOffset;
+    for (uint32_t i = 0; i < header.materialCount; ++i) {
+        uint32_t nameLength;
+        if (!fitsInFile(offset, sizeof(nameLength), size)) return false;
+        std::memcpy(&nameLength, base + offset, sizeof(nameLength));
+        offset += sizeof(nameLength);
+        if (!fitsInFile(offset, nameLength, size)) return false;
+        std::string name(base + offset, nameLength);
+        offset = alignTo4(offset + nameLength);
+        float values[11];
+        if (!fitsInFile(offset, sizeof(values), size)) return false;
+        std::memcpy(values, base + offset, sizeof(values));
+        offset += sizeof(values);
+        Material mat;
+        mat.Kd = glm::vec3(values[0], values[1], values[2]);
+        mat.Ka = glm::vec3(values[3], values[4], values[5]);
+        mat.Ks = glm::vec3(values[6], values[7], values[8]);
+        mat.Ns = values[9];
+        mat.d = values[10];
+        materials.push_back(mat);
+        materialNames.push_back(name);
+    }
+
+    // Opsezi materijala
+    std::vector<MaterialRange> ranges(header.rangeCount);
+    for (uint32_t i = 0; i < header.rangeCount; ++i) {
+        MeshCacheRange range;
+        std::memcpy(&range, base + header.rangesOffset + i * sizeof(MeshCacheRange), sizeof(range));
+        if ((uint64_t)range.first + range.count > header.indexCount) return false;
+        ranges[i] = { range.first, range.count, range.materialID };
+    }
+
+    model.materials = std::move(materials);
+    model.materialNames = std::move(materialNames);
+    model.ranges = std::move(ranges);
+    model.vertexCount = header.vertexCount;
+    model.indexCount = header.indexCount;
+    model.indexSize = header.indexSize;
+    model.quantization.scale = glm::vec3(header.posScale[0], header.posScale[1], header.posScale[2]);
+    model.quantization.bias = glm::vec3(header.posBias[0], header.posBias[1], header.posBias[2]);
+
+    // Vertex-i i indeksi idu na GPU direktno iz mapiranog fajla (pokazivači ostaju važeći i posle premeštanja mapiranja)
+    upload.vertexData = (const PackedVertex*)(base + header.verticesOffset);
+    upload.indexData = base + header.indicesOffset;
+    upload.cache = std::move(cache);
+    return true;
+}
+
+bool loadMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, OBJModel& model) {
+    OBJUploadData upload;
+    if (!readMeshCache(objPath, objHash, flags, model, upload))
+        return false;
+    uploadPreparedOBJ(model, upload);
+    return true;
+}
+
+bool writeMeshCache(const char* objPath, uint64_t objHash, uint32_t flags, const std::string& mtlPath, const OBJModel& model) {
+    MeshCacheHeader header = {};
+    std::memcpy(header.magic, meshCacheMagic, 4);
+    header.version = MESH_CACHE_VERSION;
+    header.objHash = objHash;
+    header.mtlHash = hashFile(mtlPath);
+    header.mtlPathLength = (uint32_t)mtlPath.size();
+    header.materialCount = (uint32_t)model.materials.size();
+    header.vertexStride = sizeof(PackedVertex);
+    header.vertexCount = (uint32_t)model.vertices.size();
+    header.indexCount = (uint32_t)model.indices.size();
+    header.indexSize = model.indexSize;
+    for (int axis = 0; axis < 3; ++axis) {
+        header.posScale[axis] = model.quantization.scale[axis];
+        header.posBias[axis] = model.quantization.bias[axis];
+    }
+    header.flags = flags;
+
+    std::vector<MeshCacheRange> ranges;
+    for (const MaterialRange& range : model.ranges)
+        ranges.push_back({ range.first, range.count, range.materialSlot });
+    header.rangeCount = (uint32_t)ranges.size();
+
+    // Serijalizacija tabele materijala
+    std::vector<char> materialBlob;
+    for (size_t slot = 0; slot < model.materials.size(); ++slot) {
+        const std::string& name = model.materialNames[slot];
+        uint32_t nameLength = (uint32_t)name.size();
+        const char* lengthBytes = (const char*)&nameLength;
+        materialBlob.insert(materialBlob.end(), lengthBytes, lengthBytes + sizeof(nameLength));
+        materialBlob.insert(materialBlob.end(), name.begin(), name.end());
+        materialBlob.resize(alignTo4(materialBlob.size()), 0);
+        const Material& mat = model.materials[slot];
+        float values[11] = { mat.Kd.r, mat.Kd.g, mat.Kd.b, mat.Ka.r, mat.Ka.g, mat.Ka.b,
+                             mat.Ks.r, mat.Ks.g, mat.Ks.b, mat.Ns, mat.d };
+        const char* valueBytes = (const char*)values;
+        materialBlob.insert(materialBlob.end(), valueBytes, valueBytes + sizeof(values));
+    }
+
+    header.materialsOffset = alignTo4(sizeof(MeshCacheHeader) + header.mtlPathLength);
+    header.rangesOffset = header.materialsOffset + materialBlob.size();
+    header.verticesOffset = header.rangesOffset + ranges.size() * sizeof(MeshCacheRange);
+    header.indicesOffset = header.verticesOffset + model.vertices.size() * sizeof(PackedVertex);
+    std::vector<uint16_t> shortIndices;
+    const void* indexData = objIndexData(model, shortIndices);
+
+    // Zaglavlje sa putanjom, materijalima i opsezima je malo, pa ga slažemo u jedan blok;
+    // temena i indekse spajamo u drugi
+    std::vector<char> prefix(header.verticesOffset, 0);
+    std::memcpy(prefix.data(), &header, sizeof(header));
+    std::memcpy(prefix.data() + sizeof(header), mtlPath.data(), mtlPath.size());
+    std::memcpy(prefix.data() + header.materialsOffset, materialBlob.data(), materialBlob.size());
+    std::memcpy(prefix.data() + header.rangesOffset, ranges.data(), ranges.size() * sizeof(MeshCacheRange));
+    size_t vertexBytes = model.vertices.size() * sizeof(PackedVertex);
+    size_t indexBytes = model.indices.size() * model.indexSize;
+    std::vector<char> payload(vertexBytes + indexBytes);
+    std::memcpy(payload.data(), model.vertices.data(), vertexBytes);
+    std::memcpy(payload.data() + vertexBytes, indexData, indexBytes);
+
+    std::string path = meshCachePath(objPath);
+    if (!writeFileAtomically(path.c_str(), prefix.data(), prefix.size(), payload.data(), payload.size())) {
+        std::cout << "Greska pri upisu kesa modela: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Kes modela upisan: " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,302 @@
+#include "../Header/MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Parametri Forsyth algoritma ("Linear-Speed Vertex Cache Optimisation", T. Forsyth)
+static const int FORSYTH_CACHE_SIZE = 32;
+static const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+static const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+static const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+static const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+static const int FORSYTH_MAX_VALENCE = 64;  // veće valence koriste istu (najmanju) vrednost
+
+// Tabele ocena se računaju jednom, da se pow ne poziva u unutrašnjoj petlji
+struct ForsythScoreTables {
+    float cache[FORSYTH_CACHE_SIZE];
+    float valence[FORSYTH_MAX_VALENCE + 1];
+
+    ForsythScoreTables() {
+        for (int i = 0; i < FORSYTH_CACHE_SIZE; ++i) {
+            if (i < 3) {
+                // Vertex-i poslednjeg trougla dobijaju fiksnu ocenu da se ne bi odmah ponovo koristili
+                cache[i] = FORSYTH_LAST_TRIANGLE_SCORE;
+            } else {
+                float scaler = 1.0f / (float)(FORSYTH_CACHE_SIZE - 3);
+                cache[i] = std::pow(1.0f - (float)(i - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+            }
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i <= FORSYTH_MAX_VALENCE; ++i)
+            valence[i] = FORSYTH_VALENCE_BOOST_SCALE * std::pow((float)i, -FORSYTH_VALENCE_BOOST_POWER);
+    }
+};
+
+static float forsythVertexScore(int cachePosition, unsigned int remainingTriangles) {
+    static const ForsythScoreTables tables;
+    if (remainingTriangles == 0)
+        return -1.0f;  // vertex više nije ni u jednom trouglu
+    float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+    return score + tables.valence[std::min(remainingTriangles, (unsigned int)FORSYTH_MAX_VALENCE)];
+}
+
+VertexCacheStats analyzeVertexCache(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize) {
+    VertexCacheStats stats = { 0.0f, 0.0f };
+    if (indexCount < 3 || vertexCount == 0)
+        return stats;
+
+    // FIFO keš preko vremenskih oznaka: vertex je u kešu ako je ubačen u poslednjih cacheSize promašaja
+    std::vector<unsigned int> insertedAt(vertexCount, 0);
+    std::vector<unsigned char> used(vertexCount, 0);
+    unsigned int timestamp = cacheSize + 1;
+    size_t misses = 0, usedVertices = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        unsigned int v = indices[i];
+        if (timestamp - insertedAt[v] > cacheSize) {
+            insertedAt[v] = timestamp++;
+            ++misses;
+        }
+        if (!used[v]) {
+            used[v] = 1;
+            ++usedVertices;
+        }
+    }
+    stats.acmr = (float)misses / (float)(indexCount / 3);
+    stats.atvr = (float)misses / (float)usedVertices;
+    return stats;
+}
+
+void optimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0)
+        return;
+
+    // Opseg jednog materijala obično koristi usku grupu vertex-a, pa se radi sa lokalnim brojevima
+    unsigned int minVertex = indices[0], maxVertex = indices[0];
+    for (size_t i = 1; i < triangleCount * 3; ++i) {
+        minVertex = std::min(minVertex, indices[i]);
+        maxVertex = std::max(maxVertex, indices[i]);
+    }
+    const size_t localCount = (size_t)(maxVertex - minVertex) + 1;
+
+    // Lista susednih trouglova po vertex-u (CSR)
+    std::vector<unsigned int> remaining(localCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i)
+        remaining[indices[i] - minVertex]++;
+    std::vector<unsigned int> adjacencyOffset(localCount + 1, 0);
+    for (size_t v = 0; v < localCount; ++v)
+        adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+    std::vector<unsigned int> adjacency(triangleCount * 3);
+    {
+        std::vector<unsigned int> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+        for (size_t t = 0; t < triangleCount; ++t)
+            for (int k = 0; k < 3; ++k)
+                adjacency[fill[indices[t * 3 + k] - minVertex]++] = (unsigned int)t;
+    }
+
+    std::vector<float> vertexScore(localCount);
+    for (size_t v = 0; v < localCount; ++v)
+        vertexScore[v] = forsythVertexScore(-1, remaining[v]);
+
+    std::vector<float> triangleScore(triangleCount);
+    std::vector<unsigned char> emitted(triangleCount, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const unsigned int* tri = indices + t * 3;
+        triangleScore[t] = vertexScore[tri[0] - minVertex] + vertexScore[tri[1] - minVertex] + vertexScore[tri[2] - minVertex];
+    }
+
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+
+    unsigned int cache[FORSYTH_CACHE_SIZE + 3];
+    unsigned int newCache[FORSYTH_CACHE_SIZE + 3];
+    int cacheCount = 0;
+
+    // Početni trougao je onaj sa najboljom ocenom; posle toga se traži samo među susedima keša
+    size_t bestTriangle = 0;
+    for (size_t t = 1; t < triangleCount; ++t)
+        if (triangleScore[t] > triangleScore[bestTriangle]) bestTriangle = t;
+    size_t deadEndCursor = 0;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle == (size_t)-1) {
+            // Nijedan trougao u kešu nije preostao – nastavljamo od prvog neemitovanog
+            while (emitted[deadEndCursor]) ++deadEndCursor;
+            bestTriangle = deadEndCursor;
+        }
+
+        const unsigned int* tri = indices + bestTriangle * 3;
+        unsigned int a = tri[0] - minVertex, b = tri[1] - minVertex, c = tri[2] - minVertex;
+        output.push_back(tri[0]);
+        output.push_back(tri[1]);
+        output.push_back(tri[2]);
+        emitted[bestTriangle] = 1;
+
+        // Uklanjanje trougla iz lista susednih trouglova njegovih vertex-a
+        for (unsigned int v : { a, b, c }) {
+            unsigned int* list = adjacency.data() + adjacencyOffset[v];
+            unsigned int& count = remaining[v];
+            for (unsigned int i = 0; i < count; ++i) {
+                if (list[i] == bestTriangle) {
+                    list[i] = list[count - 1];
+                    --count;
+                    break;
+                }
+            }
+        }
+
+        // Novi LRU keš: vertex-i emitovanog trougla na početak, ostali se pomeraju
+        int newCount = 0;
+        newCache[newCount++] = a;
+        if (b != a) newCache[newCount++] = b;
+        if (c != a && c != b) newCache[newCount++] = c;
+        for (int i = 0; i < cacheCount; ++i) {
+            unsigned int v = cache[i];
+            if (v != a && v != b && v != c)
+                newCache[newCount++] = v;
+        }
+
+        // Ažuriranje ocena vertex-a u kešu (i izbačenih) i njihovih trouglova
+        for (int i = 0; i < newCount; ++i) {
+            unsigned int v = newCache[i];
+            int position = i < FORSYTH_CACHE_SIZE ? i : -1;
+            float score = forsythVertexScore(position, remaining[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+            const unsigned int* list = adjacency.data() + adjacencyOffset[v];
+            for (unsigned int j = 0; j < remaining[v]; ++j)
+                triangleScore[list[j]] += delta;
+        }
+
+        cacheCount = std::min(newCount, FORSYTH_CACHE_SIZE);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        // Sledeći trougao: najbolji među trouglovima vertex-a koji su ostali u kešu
+        bestTriangle = (size_t)-1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < cacheCount; ++i) {
+            unsigned int v = cache[i];
+            const unsigned int* list = adjacency.data() + adjacencyOffset[v];
+            for (unsigned int j = 0; j < remaining[v]; ++j) {
+                if (triangleScore[list[j]] > bestScore) {
+                    bestScore = triangleScore[list[j]];
+                    bestTriangle = list[j];
+                }
+            }
+        }
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+void optimizeOverdraw(unsigned int* indices, size_t indexCount, const float* positions, size_t positionStride, size_t vertexCount) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0)
+        return;
+
+    VertexCacheStats before = analyzeVertexCache(indices, triangleCount * 3, vertexCount);
+
+    // Granice klastera: trougao čija su sva tri vertex-a promašaj u kešu (Forsyth je tu "skočio")
+    const size_t MIN_CLUSTER_TRIANGLES = 16;
+    std::vector<size_t> clusterStart;
+    {
+        std::vector<unsigned int> insertedAt(vertexCount, 0);
+        unsigned int timestamp = VERTEX_CACHE_SIM_SIZE + 1;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                unsigned int v = indices[t * 3 + k];
+                if (timestamp - insertedAt[v] > VERTEX_CACHE_SIM_SIZE) {
+                    insertedAt[v] = timestamp++;
+                    ++misses;
+                }
+            }
+            if (t == 0 || (misses == 3 && t - clusterStart.back() >= MIN_CLUSTER_TRIANGLES))
+                clusterStart.push_back(t);
+        }
+    }
+    if (clusterStart.size() < 2)
+        return;
+
+    auto position = [&](unsigned int v, int axis) { return positions[(size_t)v * positionStride + axis]; };
+
+    // Centar opsega (težište trouglova po površini) kao referentna tačka
+    struct ClusterInfo { size_t first, count; float centroid[3], normal[3], area; float sortKey; };
+    std::vector<ClusterInfo> clusters(clusterStart.size());
+    float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        ClusterInfo& cluster = clusters[c];
+        cluster.first = clusterStart[c];
+        cluster.count = (c + 1 < clusterStart.size() ? clusterStart[c + 1] : triangleCount) - cluster.first;
+        cluster.centroid[0] = cluster.centroid[1] = cluster.centroid[2] = 0.0f;
+        cluster.normal[0] = cluster.normal[1] = cluster.normal[2] = 0.0f;
+        cluster.area = 0.0f;
+        for (size_t t = cluster.first; t < cluster.first + cluster.count; ++t) {
+            unsigned int i0 = indices[t * 3], i1 = indices[t * 3 + 1], i2 = indices[t * 3 + 2];
+            float e1[3], e2[3], n[3];
+            for (int k = 0; k < 3; ++k) {
+                e1[k] = position(i1, k) - position(i0, k);
+                e2[k] = position(i2, k) - position(i0, k);
+            }
+            n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+            n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+            n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+            float area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (int k = 0; k < 3; ++k) {
+                cluster.centroid[k] += area * (position(i0, k) + position(i1, k) + position(i2, k)) / 3.0f;
+                cluster.normal[k] += n[k];  // dužina n je dvostruka površina, pa je suma već otežana
+            }
+            cluster.area += area;
+        }
+        for (int k = 0; k < 3; ++k)
+            meshCentroid[k] += cluster.centroid[k];
+        meshArea += cluster.area;
+        if (cluster.area > 0.0f)
+            for (int k = 0; k < 3; ++k) cluster.centroid[k] /= cluster.area;
+    }
+    if (meshArea <= 0.0f)
+        return;
+    for (int k = 0; k < 3; ++k)
+        meshCentroid[k] /= meshArea;
+
+    // Klasteri okrenuti "ka spolja" (Nehab i sar.) crtaju se prvi – oni najčešće zaklanjaju ostale
+    for (ClusterInfo& cluster : clusters) {
+        float length = std::sqrt(cluster.normal[0] * cluster.normal[0] + cluster.normal[1] * cluster.normal[1] + cluster.normal[2] * cluster.normal[2]);
+        float key = 0.0f;
+        if (length > 0.0f)
+            for (int k = 0; k < 3; ++k)
+                key += (cluster.centroid[k] - meshCentroid[k]) * cluster.normal[k] / length;
+        cluster.sortKey = key;
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const ClusterInfo& x, const ClusterInfo& y) {
+        return x.sortKey > y.sortKey;
+    });
+
+    std::vector<unsigned int> sorted;
+    sorted.reserve(triangleCount * 3);
+    for (const ClusterInfo& cluster : clusters)
+        sorted.insert(sorted.end(), indices + cluster.first * 3, indices + (cluster.first + cluster.count) * 3);
+
+    // Ako sortiranje previše pokvari keš, zadržavamo redosled od Forsyth-a
+    VertexCacheStats after = analyzeVertexCache(sorted.data(), sorted.size(), vertexCount);
+    if (after.acmr <= before.acmr * 1.05f)
+        std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+std::vector<unsigned int> optimizeVertexFetch(unsigned int* indices, size_t indexCount, size_t vertexCount) {
+    const unsigned int UNUSED = 0xFFFFFFFFu;
+    std::vector<unsigned int> remap(vertexCount, UNUSED);
+    unsigned int next = 0;
+    for (size_t i = 0; i < indexCount; ++i) {
+        unsigned int& target = remap[indices[i]];
+        if (target == UNUSED)
+            target = next++;
+        indices[i] = target;
+    }
+    for (unsigned int& target : remap)
+        if (target == UNUSED)
+            target = next++;
+    return remap;
+}
@@ -0,0 +1,716 @@
+#include "../Header/Model.h"
+#include "../Header/MeshCache.h"
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+#include "../Header/ObjTokenizer.h"
+#include "../Header/VertexHashMap.h"
+#include "../Header/MeshOptimizer.h"
+#include "../Header/Util.h"
+
+#include <iostream>
+#include <map>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+
+// Funkcija za učitavanje .mtl fajla
+std::map<std::string, Material> loadMTL(const char* mtlPath) {
+    std::map<std::string, Material> materials;
+    Material currentMaterial = {};  // Inicijalizuj na default vrednosti
+    std::string currentMaterialName;
+    
+    MappedFile file;
+    if (!file.open(mtlPath)) {
+        std::cout << "Greska pri otvaranju .mtl fajla: " << mtlPath << std::endl;
+        return materials;
+    }
+    
+    const char* pos = file.data();
+    const char* bufferEnd = file.data() + file.size();
+    ObjTokenizer line;
+    while (nextObjLine(pos, bufferEnd, line)) {
+        std::string_view type = line.nextToken();
+        
+        if (type == "newmtl") {
+            // Sačuvaj prethodni materijal ako postoji
+            if (!currentMaterialName.empty()) {
+                materials[currentMaterialName] = currentMaterial;
+            }
+            // Novi materijal
+            currentMaterialName = std::string(line.nextToken());
+            // Resetuj na default vrednosti
+            currentMaterial.Kd = glm::vec3(0.8f, 0.8f, 0.8f);
+            currentMaterial.Ka = glm::vec3(0.2f, 0.2f, 0.2f);
+            currentMaterial.Ks = glm::vec3(0.0f, 0.0f, 0.0f);
+            currentMaterial.Ns = 10.0f;
+            currentMaterial.d = 1.0f;
+        }
+        else if (type == "Kd" && !currentMaterialName.empty()) {
+            line.parseFloat(currentMaterial.Kd.r) && line.parseFloat(currentMaterial.Kd.g) && line.parseFloat(currentMaterial.Kd.b);
+        }
+        else if (type == "Ka" && !currentMaterialName.empty()) {
+            line.parseFloat(currentMaterial.Ka.r) && line.parseFloat(currentMaterial.Ka.g) && line.parseFloat(currentMaterial.Ka.b);
+        }
+        else if (type == "Ks" && !currentMaterialName.empty()) {
+            line.parseFloat(currentMaterial.Ks.r) && line.parseFloat(currentMaterial.Ks.g) && line.parseFloat(currentMaterial.Ks.b);
+        }
+        else if (type == "Ns" && !currentMaterialName.empty()) {
+            line.parseFloat(currentMaterial.Ns);
+        }
+        else if (type == "d" && !currentMaterialName.empty()) {
+            line.parseFloat(currentMaterial.d);
+        }
+    }
+    
+    // Sačuvaj poslednji materijal
+    if (!currentMaterialName.empty()) {
+        materials[currentMaterialName] = currentMaterial;
+    }
+    
+    std::cout << "Ucitano " << materials.size() << " materijala iz .mtl fajla!" << std::endl;
+    
+    return materials;
+}
+
+// Deo .obj fajla (skup celih linija) koji se parsira na posebnoj niti
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+    
+    // Broj v/vt/vn linija u ovom delu i ukupno pre njega (za razrešavanje relativnih indeksa)
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    size_t positionOffset = 0, texCoordOffset = 0, normalOffset = 0;
+    
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<unsigned int> posIndices, texIndices, normIndices;  // Globalni indeksi, 3 po trouglu
+    
+    // usemtl/mtllib linije redom, uz broj trouglova ovog dela pre njih
+    struct MaterialEvent {
+        bool isLibrary;
+        std::string name;
+        size_t triangle;
+    };
+    std::vector<MaterialEvent> materialEvents;
+};
+
+// Manji fajlovi se parsiraju na jednoj niti – pokretanje niti bi koštalo više od dobitka
+static const size_t OBJ_MIN_CHUNK_SIZE = 1 << 20;
+
+// Pokreće fn(i) za i = 0..count-1, svaki na svojoj niti (nulti na pozivajućoj)
+template <typename Fn>
+static void runChunksInParallel(size_t count, Fn fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; ++i)
+        workers.emplace_back(fn, i);
+    if (count > 0)
+        fn((size_t)0);
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+// Deli bafer na delove približno iste veličine, uvek na granici linije
+static std::vector<ObjChunk> splitObjBuffer(const char* data, size_t size, unsigned int threadCount) {
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    size_t chunkCount = std::min<size_t>(threadCount, std::max<size_t>(1, size / OBJ_MIN_CHUNK_SIZE));
+    
+    std::vector<ObjChunk> chunks;
+    const char* bufferEnd = data + size;
+    const char* begin = data;
+    for (size_t i = 0; i < chunkCount && begin < bufferEnd; ++i) {
+        const char* end = bufferEnd;
+        if (i + 1 < chunkCount) {
+            end = std::max(begin, data + size / chunkCount * (i + 1));
+            const char* newline = (const char*)std::memchr(end, '\n', (size_t)(bufferEnd - end));
+            end = newline ? newline + 1 : bufferEnd;
+        }
+        ObjChunk chunk;
+        chunk.begin = begin;
+        chunk.end = end;
+        chunks.push_back(std::move(chunk));
+        begin = end;
+    }
+    if (chunks.empty()) {
+        ObjChunk chunk;
+        chunk.begin = chunk.end = data;
+        chunks.push_back(std::move(chunk));
+    }
+    return chunks;
+}
+
+// Prvi prolaz: samo brojanje v/vt/vn linija
+static void countObjChunk(ObjChunk& chunk) {
+    const char* pos = chunk.begin;
+    ObjTokenizer line;
+    while (nextObjLine(pos, chunk.end, line)) {
+        std::string_view type = line.nextToken();
+        if (type == "v") ++chunk.positionCount;
+        else if (type == "vt") ++chunk.texCoordCount;
+        else if (type == "vn") ++chunk.normalCount;
+    }
+}
+
+// Drugi prolaz: parsiranje podataka i lica; indeksi se odmah pretvaraju u globalne
+static void parseObjChunk(ObjChunk& chunk) {
+    chunk.positions.reserve(chunk.positionCount);
+    chunk.texCoords.reserve(chunk.texCoordCount);
+    chunk.normals.reserve(chunk.normalCount);
+    
+    // Uglovi trenutnog lica – vektori se samo prazne, pa posle prvih lica nema novih alokacija
+    std::vector<unsigned int> facePos, faceTex, faceNorm;
+    size_t triangleCount = 0;
+    
+    const char* pos = chunk.begin;
+    ObjTokenizer line;
+    while (nextObjLine(pos, chunk.end, line)) {
+        std::string_view type = line.nextToken();
+        
+        if (type == "v") {
+            glm::vec3 p(0.0f);
+            line.parseFloat(p.x) && line.parseFloat(p.y) && line.parseFloat(p.z);
+            chunk.positions.push_back(p);
+        }
+        else if (type == "vt") {
+            glm::vec2 tex(0.0f);
+            line.parseFloat(tex.x) && line.parseFloat(tex.y);
+            chunk.texCoords.push_back(tex);
+        }
+        else if (type == "vn") {
+            glm::vec3 norm(0.0f);
+            line.parseFloat(norm.x) && line.parseFloat(norm.y) && line.parseFloat(norm.z);
+            chunk.normals.push_back(norm);
+        }
+        else if (type == "f") {
+            facePos.clear();
+            faceTex.clear();
+            faceNorm.clear();
+            
+            // Parsiranje formata v/vt/vn ili v//vn ili v/vt; komponenta koja nedostaje dobija indeks 0
+            long v, vt, vn;
+            while (!line.atEnd()) {
+                if (!line.parseFaceCorner(v, vt, vn))
+                    continue;
+                facePos.push_back(resolveObjIndex(v, chunk.positionOffset + chunk.positions.size()));
+                faceTex.push_back(vt ? resolveObjIndex(vt, chunk.texCoordOffset + chunk.texCoords.size()) : 0);
+                faceNorm.push_back(vn ? resolveObjIndex(vn, chunk.normalOffset + chunk.normals.size()) : 0);
+            }
+            
+            // Triangulacija (pretvaranje kvadova u trouglove)
+            if (facePos.size() >= 3) {
+                for (size_t i = 1; i < facePos.size() - 1; ++i) {
+                    chunk.posIndices.push_back(facePos[0]);
+                    chunk.posIndices.push_back(facePos[i]);
+                    chunk.posIndices.push_back(facePos[i + 1]);
+                    
+                    chunk.texIndices.push_back(faceTex[0]);
+                    chunk.texIndices.push_back(faceTex[i]);
+                    chunk.texIndices.push_back(faceTex[i + 1]);
+                    
+                    chunk.normIndices.push_back(faceNorm[0]);
+                    chunk.normIndices.push_back(faceNorm[i]);
+                    chunk.normIndices.push_back(faceNorm[i + 1]);
+                    ++triangleCount;
+                }
+            }
+        }
+        else if (type == "usemtl") {
+            chunk.materialEvents.push_back({ false, std::string(line.nextToken()), triangleCount });
+        }
+        else if (type == "mtllib") {
+            chunk.materialEvents.push_back({ true, std::string(line.nextToken()), triangleCount });
+        }
+    }
+}
+
+// Stanje materijala tokom parsiranja: usemtl/mtllib linije redom menjaju ID materijala za sledeće trouglove
+struct ObjMaterialState {
+    std::map<std::string, Material> materials;     // Materijali iz poslednjeg mtllib, po imenu
+    std::map<std::string, unsigned int> nameToID;  // Mapa imena materijala na ID
+    std::string currentMaterial = "";              // Trenutni materijal
+    unsigned int nextID = 0;
+    unsigned int currentID = 0;                    // Default materijal
+    
+    void apply(bool isLibrary, const std::string& name, const std::string& objDir, std::string& mtlPath) {
+        if (!isLibrary) {
+            currentMaterial = name;
+        } else {
+            mtlPath = objDir + name;
+            materials = loadMTL(mtlPath.c_str());
+            // Osiguraj da dno automata uvek ima tamno metalno sivo (floor_metal)
+            if (materials.find("floor_metal") == materials.end()) {
+                Material floorMat;
+                floorMat.Kd = glm::vec3(0.22f, 0.24f, 0.26f);
+                floorMat.Ka = glm::vec3(0.12f, 0.14f, 0.16f);
+                floorMat.Ks = glm::vec3(0.45f, 0.48f, 0.52f);
+                floorMat.Ns = 100.0f;
+                floorMat.d = 1.0f;
+                materials["floor_metal"] = floorMat;
+            }
+            // Kreiraj mapu imena materijala na ID
+            for (const auto& pair : materials) {
+                nameToID[pair.first] = nextID++;
+            }
+        }
+        // Pronađi materijal ID za trenutni materijal
+        auto it = nameToID.find(currentMaterial);
+        currentID = (it != nameToID.end()) ? it->second : 0;
+    }
+    
+    // Materijali po slotu – slot je redni broj u mapi, kao i ID dodeljen pri mtllib
+    void fillModelMaterials(OBJModel& model) const {
+        for (const auto& pair : materials) {
+            model.materialNames.push_back(pair.first);
+            model.materials.push_back(pair.second);
+        }
+    }
+};
+
+// Granice pozicija za kvantizaciju (vidi VertexFormat.h)
+static VertexQuantization positionQuantization(const std::vector<glm::vec3>& positions) {
+    if (positions.empty())
+        return VertexQuantization();
+    glm::vec3 boundsMin = positions[0], boundsMax = positions[0];
+    for (const glm::vec3& position : positions) {
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+    return makeVertexQuantization(boundsMin, boundsMax);
+}
+
+// Kompaktni vertex za (pos, tex, norm) trojku; nedostajući podaci: pozicija (0,0,0), UV (0,0), normala (0,1,0)
+static PackedVertex packObjVertex(unsigned int posIdx, unsigned int texIdx, unsigned int normIdx,
+                                  const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+                                  const std::vector<glm::vec3>& normals, const VertexQuantization& quantization) {
+    glm::vec3 position = (posIdx < positions.size()) ? positions[posIdx] : glm::vec3(0.0f);
+    glm::vec2 texCoord = (texIdx < texCoords.size()) ? texCoords[texIdx] : glm::vec2(0.0f);
+    glm::vec3 normal = (normIdx < normals.size()) ? normals[normIdx] : glm::vec3(0.0f, 1.0f, 0.0f);
+    return packVertex(position, texCoord, normal, quantization);
+}
+
+// Stabilno sortiranje trouglova po materijalu (counting sort) i pravljenje po jednog opsega za svaki materijal.
+// ID van tabele (usemtl pre mtllib, nepoznato ime, stari ID iz ranijeg mtllib) ide u slot 0,
+// kao što je ranije crtanje koristilo prvi materijal kao podrazumevani.
+static void sortTrianglesByMaterial(OBJModel& model, const std::vector<unsigned int>& triangleMaterialIDs) {
+    const size_t triangleCount = model.indices.size() / 3;
+    const size_t slotCount = std::max<size_t>(model.materials.size(), 1);
+    std::vector<unsigned int> slotOffset(slotCount + 1, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        unsigned int slot = triangleMaterialIDs[t] < slotCount ? triangleMaterialIDs[t] : 0;
+        slotOffset[slot + 1]++;
+    }
+    for (size_t slot = 0; slot < slotCount; ++slot) {
+        if (slotOffset[slot + 1] > 0)
+            model.ranges.push_back({ slotOffset[slot] * 3, slotOffset[slot + 1] * 3, (unsigned int)slot });
+        slotOffset[slot + 1] += slotOffset[slot];
+    }
+    if (model.ranges.size() <= 1)
+        return;  // jedan materijal – redosled se ne menja
+    
+    std::vector<unsigned int> sorted(triangleCount * 3);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        unsigned int slot = triangleMaterialIDs[t] < slotCount ? triangleMaterialIDs[t] : 0;
+        unsigned int target = slotOffset[slot]++;
+        std::copy(model.indices.begin() + t * 3, model.indices.begin() + t * 3 + 3, sorted.begin() + (size_t)target * 3);
+    }
+    model.indices.swap(sorted);
+}
+
+// Parsiranje .obj teksta iz bafera u interleaved vertex-e i indekse (bez GL poziva).
+// Bafer se deli na delove po linijama koji se parsiraju paralelno, a zatim spajaju redom,
+// pa je rezultat identičan parsiranju na jednoj niti.
+bool parseOBJBuffer(const char* data, size_t size, const std::string& objDir, OBJModel& model, std::string& mtlPath, unsigned int threadCount) {
+    std::vector<ObjChunk> chunks = splitObjBuffer(data, size, threadCount);
+    
+    runChunksInParallel(chunks.size(), [&chunks](size_t i) { countObjChunk(chunks[i]); });
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        chunks[i].positionOffset = chunks[i - 1].positionOffset + chunks[i - 1].positionCount;
+        chunks[i].texCoordOffset = chunks[i - 1].texCoordOffset + chunks[i - 1].texCoordCount;
+        chunks[i].normalOffset = chunks[i - 1].normalOffset + chunks[i - 1].normalCount;
+    }
+    runChunksInParallel(chunks.size(), [&chunks](size_t i) { parseObjChunk(chunks[i]); });
+    
+    // Spajanje delova redom
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    std::vector<unsigned int> posIndices, texIndices, normIndices;
+    std::vector<unsigned int> materialIDs;  // Materijal ID za svaki trougao
+    ObjMaterialState materialState;
+    
+    const ObjChunk& last = chunks.back();
+    positions.reserve(last.positionOffset + last.positionCount);
+    texCoords.reserve(last.texCoordOffset + last.texCoordCount);
+    normals.reserve(last.normalOffset + last.normalCount);
+    size_t totalCorners = 0;
+    for (const ObjChunk& chunk : chunks)
+        totalCorners += chunk.posIndices.size();
+    posIndices.reserve(totalCorners);
+    texIndices.reserve(totalCorners);
+    normIndices.reserve(totalCorners);
+    materialIDs.reserve(totalCorners / 3);
+    
+    for (ObjChunk& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        posIndices.insert(posIndices.end(), chunk.posIndices.begin(), chunk.posIndices.end());
+        texIndices.insert(texIndices.end(), chunk.texIndices.begin(), chunk.texIndices.end());
+        normIndices.insert(normIndices.end(), chunk.normIndices.begin(), chunk.normIndices.end());
+        
+        // Materijal se prenosi iz prethodnog dela; menja se samo na usemtl/mtllib
+        size_t chunkTriangles = chunk.posIndices.size() / 3;
+        size_t triangle = 0;
+        for (size_t e = 0; e <= chunk.materialEvents.size(); ++e) {
+            size_t until = (e < chunk.materialEvents.size()) ? chunk.materialEvents[e].triangle : chunkTriangles;
+            // Dodeli materijal ID za svaki trougao
+            materialIDs.insert(materialIDs.end(), until - triangle, materialState.currentID);
+            triangle = until;
+            if (e == chunk.materialEvents.size())
+                break;
+            
+            const ObjChunk::MaterialEvent& event = chunk.materialEvents[e];
+            materialState.apply(event.isLibrary, event.name, objDir, mtlPath);
+        }
+        
+        // Delovi se oslobađaju odmah, da vršna potrošnja memorije ne raste sa brojem niti
+        chunk = ObjChunk();
+    }
+    
+    model.quantization = positionQuantization(positions);
+    
+    // Kreiranje kompaktnog vertex buffer-a
+    // Procena broja jedinstvenih vertex-a: bar onoliko koliko ima pozicija/normala/UV-a
+    size_t expectedVertices = std::max(positions.size(), std::max(texCoords.size(), normals.size()));
+    VertexHashMap vertexMap(expectedVertices);
+    unsigned int currentIndex = 0;
+    model.vertices.reserve(expectedVertices);
+    model.indices.reserve(posIndices.size());
+    
+    for (size_t i = 0; i < posIndices.size(); ++i) {
+        unsigned int posIdx = posIndices[i];
+        unsigned int texIdx = texIndices[i];
+        unsigned int normIdx = normIndices[i];
+        
+        bool inserted;
+        unsigned int index = vertexMap.findOrInsert(posIdx, texIdx, normIdx, currentIndex, inserted);
+        
+        if (inserted) {
+            currentIndex++;
+            model.vertices.push_back(packObjVertex(posIdx, texIdx, normIdx, positions, texCoords, normals, model.quantization));
+        }
+        
+        model.indices.push_back(index);
+    }
+    
+    materialState.fillModelMaterials(model);
+    sortTrianglesByMaterial(model, materialIDs);
+    
+    model.indexCount = (unsigned int)model.indices.size();
+    model.vertexCount = (unsigned int)model.vertices.size();
+    model.indexSize = (model.vertexCount <= MAX_SHORT_INDEX_VERTICES) ? 2 : 4;
+    return !model.vertices.empty() && !model.indices.empty();
+}
+
+// Koliko pročitanog teksta se skupi pre nego što se njegove stranice vrate sistemu (streaming režim)
+static const size_t OBJ_STREAMING_RELEASE_STEP = 64ull << 20;
+
+// Streaming parsiranje: jedna nit, bez nizova indeksa po uglu. Svaki ugao lica se odmah deduplikuje
+// i indeks upisuje u niz svog materijala; vertex-i se prave na kraju iz same hash tabele (ona već čuva
+// pos/tex/norm trojku), jer kvantizacija zahteva granice svih pozicija.
+bool parseOBJStreaming(const char* data, size_t size, const std::string& objDir, OBJModel& model, std::string& mtlPath, const MappedFile* source) {
+    // Prolaz brojanja je jeftin i omogućava tačne rezervacije (bez udvostručavanja vektora); ide po delovima
+    // poravnatim na linije, da ni on ne ostavi ceo fajl u memoriji pre glavnog prolaza
+    ObjChunk counts;
+    for (ObjChunk& chunk : splitObjBuffer(data, size, (unsigned int)(size / OBJ_STREAMING_RELEASE_STEP + 1))) {
+        countObjChunk(chunk);
+        counts.positionCount += chunk.positionCount;
+        counts.texCoordCount += chunk.texCoordCount;
+        counts.normalCount += chunk.normalCount;
+        if (source)
+            source->releasePages((size_t)(chunk.begin - data), (size_t)(chunk.end - chunk.begin));
+    }
+    
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+    positions.reserve(counts.positionCount);
+    texCoords.reserve(counts.texCoordCount);
+    normals.reserve(counts.normalCount);
+    
+    size_t expectedVertices = std::max(positions.capacity(), std::max(texCoords.capacity(), normals.capacity()));
+    VertexHashMap vertexMap(expectedVertices);
+    unsigned int currentIndex = 0;
+    
+    ObjMaterialState materialState;
+    std::vector<std::vector<unsigned int>> materialIndices(1);  // indeksi po materijal ID-u
+    std::vector<unsigned int> faceIndices;
+    
+    // Uzastopna lica istog materijala redom iz fajla (ID, broj indeksa); slot 0 na kraju spaja ID 0 i ID-jeve
+    // van tabele po ovom redosledu, a tabela se zna tek posle poslednjeg mtllib
+    struct MaterialRun {
+        unsigned int id;
+        size_t indexCount;
+    };
+    std::vector<MaterialRun> materialRuns;
+    
+    const char* pos = data;
+    const char* end = data + size;
+    const char* released = data;
+    ObjTokenizer line;
+    while (nextObjLine(pos, end, line)) {
+        std::string_view type = line.nextToken();
+        
+        if (type == "v") {
+            glm::vec3 p(0.0f);
+            line.parseFloat(p.x) && line.parseFloat(p.y) && line.parseFloat(p.z);
+            positions.push_back(p);
+        }
+        else if (type == "vt") {
+            glm::vec2 tex(0.0f);
+            line.parseFloat(tex.x) && line.parseFloat(tex.y);
+            texCoords.push_back(tex);
+        }
+        else if (type == "vn") {
+            glm::vec3 norm(0.0f);
+            line.parseFloat(norm.x) && line.parseFloat(norm.y) && line.parseFloat(norm.z);
+            normals.push_back(norm);
+        }
+        else if (type == "f") {
+            faceIndices.clear();
+            long v, vt, vn;
+            while (!line.atEnd()) {
+                if (!line.parseFaceCorner(v, vt, vn))
+                    continue;
+                unsigned int posIdx = resolveObjIndex(v, positions.size());
+                unsigned int texIdx = vt ? resolveObjIndex(vt, texCoords.size()) : 0;
+                unsigned int normIdx = vn ? resolveObjIndex(vn, normals.size()) : 0;
+                bool inserted;
+                faceIndices.push_back(vertexMap.findOrInsert(posIdx, texIdx, normIdx, currentIndex, inserted));
+                if (inserted)
+                    currentIndex++;
+            }
+            
+            // Triangulacija (pretvaranje kvadova u trouglove)
+            if (faceIndices.size() >= 3) {
+                std::vector<unsigned int>& target = materialIndices[materialState.currentID];
+                for (size_t i = 1; i < faceIndices.size() - 1; ++i) {
+                    target.push_back(faceIndices[0]);
+                    target.push_back(faceIndices[i]);
+                    target.push_back(faceIndices[i + 1]);
+                }
+                if (materialRuns.empty() || materialRuns.back().id != materialState.currentID)
+                    materialRuns.push_back({ materialState.currentID, 0 });
+                materialRuns.back().indexCount += (faceIndices.size() - 2) * 3;
+            }
+        }
+        else if (type == "usemtl" || type == "mtllib") {
+            materialState.apply(type == "mtllib", std::string(line.nextToken()), objDir, mtlPath);
+            if (materialState.nextID > materialIndices.size())
+                materialIndices.resize(materialState.nextID);
+        }
+        
+        // Pročitani tekst više ne treba – vraćamo stranice da vršna memorija ne raste sa veličinom fajla
+        if (source && (size_t)(pos - released) >= OBJ_STREAMING_RELEASE_STEP) {
+            source->releasePages((size_t)(released - data), (size_t)(pos - released));
+            released = pos;
+        }
+    }
+    
+    // Vertex-i iz hash tabele, pa izvorni nizovi više nisu potrebni
+    model.quantization = positionQuantization(positions);
+    model.vertices.resize(currentIndex);
+    vertexMap.forEach([&](uint32_t posIdx, uint32_t texIdx, uint32_t normIdx, uint32_t value) {
+        model.vertices[value] = packObjVertex(posIdx, texIdx, normIdx, positions, texCoords, normals, model.quantization);
+    });
+    vertexMap = VertexHashMap(0);
+    std::vector<glm::vec3>().swap(positions);
+    std::vector<glm::vec2>().swap(texCoords);
+    std::vector<glm::vec3>().swap(normals);
+    
+    // Spajanje indeksa po materijalu u jedan bafer; ID van tabele ide u slot 0 (kao u sortTrianglesByMaterial).
+    // Nizovi se oslobađaju čim se prepišu, pa vršna memorija ostaje ~ jedan bafer indeksa
+    materialState.fillModelMaterials(model);
+    const size_t slotCount = std::max<size_t>(model.materials.size(), 1);
+    size_t totalIndices = 0;
+    for (const std::vector<unsigned int>& bucket : materialIndices)
+        totalIndices += bucket.size();
+    model.indices.reserve(totalIndices);
+    
+    // Slot 0: ID 0 i ID-jevi van tabele, u redosledu iz fajla kao u parseOBJBuffer
+    std::vector<size_t> runCursor(materialIndices.size(), 0);
+    for (const MaterialRun& run : materialRuns) {
+        if (run.id != 0 && run.id < slotCount)
+            continue;
+        const std::vector<unsigned int>& bucket = materialIndices[run.id];
+        model.indices.insert(model.indices.end(), bucket.begin() + runCursor[run.id], bucket.begin() + runCursor[run.id] + run.indexCount);
+        runCursor[run.id] += run.indexCount;
+    }
+    std::vector<MaterialRun>().swap(materialRuns);
+    std::vector<unsigned int>().swap(materialIndices[0]);
+    for (size_t id = slotCount; id < materialIndices.size(); ++id)
+        std::vector<unsigned int>().swap(materialIndices[id]);
+    if (!model.indices.empty())
+        model.ranges.push_back({ 0, (unsigned int)model.indices.size(), 0 });
+    
+    for (size_t slot = 1; slot < slotCount && slot < materialIndices.size(); ++slot) {
+        std::vector<unsigned int>& bucket = materialIndices[slot];
+        if (bucket.empty())
+            continue;
+        model.ranges.push_back({ (unsigned int)model.indices.size(), (unsigned int)bucket.size(), (unsigned int)slot });
+        model.indices.insert(model.indices.end(), bucket.begin(), bucket.end());
+        std::vector<unsigned int>().swap(bucket);
+    }
+    
+    model.indexCount = (unsigned int)model.indices.size();
+    model.vertexCount = (unsigned int)model.vertices.size();
+    model.indexSize = (model.vertexCount <= MAX_SHORT_INDEX_VERTICES) ? 2 : 4;
+    return !model.vertices.empty() && !model.indices.empty();
+}
+
+// Optimizacija posle deduplikacije; opsezi materijala ostaju ispravni jer se trouglovi
+// preuređuju samo unutar svog opsega
+void optimizeOBJModel(OBJModel& model, const char* name) {
+    if (model.indices.empty() || model.vertexCount == 0)
+        return;
+    
+    VertexCacheStats before = analyzeVertexCache(model.indices.data(), model.indices.size(), model.vertexCount);
+    
+    // Overdraw sortiranju trebaju pozicije u prostoru modela
+    std::vector<glm::vec3> positions(model.vertexCount);
+    for (size_t v = 0; v < model.vertexCount; ++v)
+        positions[v] = unpackPosition(model.vertices[v], model.quantization);
+    
+    for (const MaterialRange& range : model.ranges) {
+        unsigned int* rangeIndices = model.indices.data() + range.first;
+        optimizeVertexCache(rangeIndices, range.count, model.vertexCount);
+        optimizeOverdraw(rangeIndices, range.count, glm::value_ptr(positions[0]), 3, model.vertexCount);
+    }
+    
+    std::vector<unsigned int> remap = optimizeVertexFetch(model.indices.data(), model.indices.size(), model.vertexCount);
+    remapVertexBuffer(model.vertices, remap);
+    
+    VertexCacheStats after = analyzeVertexCache(model.indices.data(), model.indices.size(), model.vertexCount);
+    std::cout << "Optimizovan model " << name << ": ACMR " << before.acmr << " -> " << after.acmr
+              << ", ATVR " << before.atvr << " -> " << after.atvr << std::endl;
+}
+
+// Hash fajla po delovima od OBJ_STREAMING_RELEASE_STEP; stranice svakog dela se vraćaju odmah posle heširanja.
+// FNV se nastavlja preko seed-a, pa je rezultat isti kao hashBytes nad celim fajlom.
+static uint64_t hashReleasingPages(const MappedFile& file) {
+    uint64_t hash = hashBytes(nullptr, 0);
+    for (size_t offset = 0; offset < file.size(); offset += OBJ_STREAMING_RELEASE_STEP) {
+        const size_t count = std::min(OBJ_STREAMING_RELEASE_STEP, file.size() - offset);
+        hash = hashBytes(file.data() + offset, count, hash);
+        file.releasePages(offset, count);
+    }
+    return hash;
+}
+
+bool prepareOBJ(const char* filePath, OBJModel& model, OBJUploadData& upload, bool optimize, ObjParseMode mode, unsigned int threadCount) {
+    MappedFile objFile;
+    if (!objFile.open(filePath)) {
+        std::cout << "Greska pri otvaranju .obj fajla: " << filePath << std::endl;
+        return false;
+    }
+    
+    if (mode == ObjParseMode::Auto)
+        mode = (objFile.size() > OBJ_STREAMING_THRESHOLD) ? ObjParseMode::Streaming : ObjParseMode::Parallel;
+    bool streaming = (mode == ObjParseMode::Streaming);
+    // Keš je vezan za sadržaj .obj fajla – ako se hash poklapa, tekstualno parsiranje se preskače.
+    // U streaming režimu se heširani delovi odmah vraćaju sistemu, da fajl ne bude ceo u memoriji pre parsiranja.
+    uint64_t objHash = streaming ? hashReleasingPages(objFile) : hashBytes(objFile.data(), objFile.size());
+    if (streaming && optimize) {
+        std::cout << "Streaming ucitavanje (" << objFile.size() / (1 << 20) << " MB), optimizacija se preskace: " << filePath << std::endl;
+        optimize = false;
+    }
+    uint32_t cacheFlags = optimize ? MESH_CACHE_OPTIMIZED : 0;
+    if (readMeshCache(filePath, objHash, cacheFlags, model, upload)) {
+        std::cout << "Model ucitan iz kesa: " << filePath << " (" << model.indexCount / 3 << " trouglova, " << model.vertexCount << " vertex-a)" << std::endl;
+        return true;
+    }
+    
+    std::string objDir = std::string(filePath);
+    size_t lastSlash = objDir.find_last_of("/\\");
+    if (lastSlash != std::string::npos) {
+        objDir = objDir.substr(0, lastSlash + 1);
+    } else {
+        objDir = "";
+    }
+    
+    std::string mtlPath = "";
+    bool hasData = streaming
+        ? parseOBJStreaming(objFile.data(), objFile.size(), objDir, model, mtlPath, &objFile)
+        : parseOBJBuffer(objFile.data(), objFile.size(), objDir, model, mtlPath, threadCount);
+    objFile.close();
+    
+    // Provera da li ima dovoljno podataka
+    if (!hasData) {
+        std::cout << "Greska: Model nema podataka!" << std::endl;
+        std::cout << "Vertices: " << model.vertices.size() << ", Indices: " << model.indices.size() << std::endl;
+        return false;
+    }
+    
+    if (optimize)
+        optimizeOBJModel(model, filePath);
+    
+    writeMeshCache(filePath, objHash, cacheFlags, mtlPath, model);
+    
+    std::cout << "Uspesno ucitano " << model.indexCount / 3 << " trouglova iz .obj fajla!" << std::endl;
+    std::cout << "Broj vertex-a: " << model.vertexCount << std::endl;
+    return true;
+}
+
+void uploadPreparedOBJ(OBJModel& model, OBJUploadData& upload) {
+    if (upload.cache.isOpen()) {
+        uploadOBJModel(model, upload.vertexData, upload.indexData);
+        upload = OBJUploadData();
+        return;
+    }
+    std::vector<uint16_t> shortIndices;
+    uploadOBJModel(model, model.vertices.data(), objIndexData(model, shortIndices));
+}
+
+// Funkcija za učitavanje .obj fajla
+OBJModel loadOBJ(const char* filePath, bool optimize, ObjParseMode mode) {
+    OBJModel model;
+    OBJUploadData upload;
+    if (prepareOBJ(filePath, model, upload, optimize, mode))
+        uploadPreparedOBJ(model, upload);
+    return model;
+}
+
+const void* objIndexData(const OBJModel& model, std::vector<uint16_t>& shortIndices) {
+    if (model.indexSize != 2)
+        return model.indices.data();
+    shortIndices = narrowIndices(model.indices.data(), model.indices.size());
+    return shortIndices.data();
+}
+
+// Kreiranje VAO, VBO, EBO za model
+void uploadOBJModel(OBJModel& model, const PackedVertex* vertexData, const void* indexData) {
+    glGenVertexArrays(1, &model.VAO);
+    glGenBuffers(1, &model.VBO);
+    glGenBuffers(1, &model.EBO);
+    
+    glBindVertexArray(model.VAO);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, model.VBO);
+    glBufferData(GL_ARRAY_BUFFER, (size_t)model.vertexCount * sizeof(PackedVertex), vertexData, GL_STATIC_DRAW);
+    
+    model.indexType = indexTypeForSize(model.indexSize);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (size_t)model.indexCount * model.indexSize, indexData, GL_STATIC_DRAW);
+    
+    setPackedVertexAttributes();
+    
+    glBindVertexArray(0);
+    
+    // Provera OpenGL greške
+    GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        std::cout << "OpenGL greska pri ucitavanju modela: " << error << std::endl;
+    }
+}
@@ -0,0 +1,71 @@
+#include "../Header/MultiDraw.h"
+#include "../Header/Model.h"
+
+#include <GL/glew.h>
+
+bool multiDrawIndirectSupported() {
+    return GLEW_VERSION_4_3 || (GLEW_ARB_multi_draw_indirect && GLEW_ARB_base_instance);
+}
+
+bool MultiDrawBatch::create(const OBJModel& model, const std::vector<MaterialRange>& ranges) {
+    if (ranges.empty() || model.VAO == 0 || !multiDrawIndirectSupported())
+        return false;
+
+    std::vector<DrawElementsIndirectCommand> commands;
+    std::vector<int32_t> materials;
+    commands.reserve(ranges.size());
+    materials.reserve(ranges.size());
+    for (const MaterialRange& range : ranges) {
+        DrawElementsIndirectCommand command;
+        command.count = range.count;
+        command.instanceCount = 1;
+        command.firstIndex = range.first;
+        command.baseVertex = 0;
+        command.baseInstance = (uint32_t)commands.size();  // indeks u baferu materijala
+        commands.push_back(command);
+        materials.push_back((int32_t)(model.materialBase + range.materialSlot));
+    }
+
+    glGenVertexArrays(1, &vertexArray);
+    glGenBuffers(1, &commandBuffer);
+    glGenBuffers(1, &materialBuffer);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, commands.size() * sizeof(DrawElementsIndirectCommand), commands.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    glBindVertexArray(vertexArray);
+    glBindBuffer(GL_ARRAY_BUFFER, model.VBO);
+    setPackedVertexAttributes();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model.EBO);
+    glBindBuffer(GL_ARRAY_BUFFER, materialBuffer);
+    glBufferData(GL_ARRAY_BUFFER, materials.size() * sizeof(int32_t), materials.data(), GL_STATIC_DRAW);
+    glVertexAttribIPointer(MULTI_DRAW_MATERIAL_ATTRIBUTE, 1, GL_INT, sizeof(int32_t), (void*)0);
+    glEnableVertexAttribArray(MULTI_DRAW_MATERIAL_ATTRIBUTE);
+    glVertexAttribDivisor(MULTI_DRAW_MATERIAL_ATTRIBUTE, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    indexType = model.indexType;
+    commandCount = (unsigned int)commands.size();
+    return true;
+}
+
+void MultiDrawBatch::draw() const {
+    if (commandCount == 0)
+        return;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commandBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (void*)0, (GLsizei)commandCount, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void MultiDrawBatch::destroy() {
+    if (commandBuffer != 0)
+        glDeleteBuffers(1, &commandBuffer);
+    if (materialBuffer != 0)
+        glDeleteBuffers(1, &materialBuffer);
+    if (vertexArray != 0)
+        glDeleteVertexArrays(1, &vertexArray);
+    commandBuffer = materialBuffer = vertexArray = 0;
+    commandCount = 0;
+}
@@ -0,0 +1,175 @@
+#include "../Header/ProgramCache.h"
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+#include "../Header/Util.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <chrono>
+
+// Raspored keš fajla: ProgramCacheHeader, pa binarni program (binarySize bajtova, format binaryFormat)
+struct ProgramCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;
+    uint64_t driverHash;
+    uint32_t binaryFormat;
+    uint32_t binarySize;
+};
+
+static const char programCacheMagic[4] = { 'K', 'P', 'R', 'G' };
+
+std::string programCachePath(const char* vsPath, const char* fsPath, const char* defines) {
+    std::string fsName = fsPath;
+    size_t slash = fsName.find_last_of("/\\");
+    if (slash != std::string::npos)
+        fsName = fsName.substr(slash + 1);
+    std::string path = std::string(vsPath) + "." + fsName;
+    if (defines && *defines) {
+        char variant[16];
+        std::snprintf(variant, sizeof(variant), ".%08x", (uint32_t)hashBytes(defines, std::strlen(defines)));
+        path += variant;
+    }
+    return path + ".programcache";
+}
+
+static bool programBinarySupported() {
+    if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary)
+        return false;
+    // Neki drajveri imaju ekstenziju ali nijedan binarni format (npr. Mesa bez shader keša)
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    return formatCount > 0;
+}
+
+static bool readSource(const char* path, std::string& source) {
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+    source.assign(file.data(), file.size());
+    return true;
+}
+
+// Binarni program je vezan za tačan drajver i GPU
+static uint64_t driverHash() {
+    uint64_t hash = hashBytes(nullptr, 0);
+    const GLenum names[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+    for (GLenum name : names) {
+        const char* value = (const char*)glGetString(name);
+        if (value)
+            hash = hashBytes(value, std::strlen(value) + 1, hash);
+    }
+    return hash;
+}
+
+static unsigned int loadProgramBinary(const std::string& path, uint64_t sourceHash, uint64_t driver) {
+    MappedFile cache;
+    if (!cache.open(path.c_str()) || cache.size() < sizeof(ProgramCacheHeader))
+        return 0;
+    ProgramCacheHeader header;
+    std::memcpy(&header, cache.data(), sizeof(header));
+    if (std::memcmp(header.magic, programCacheMagic, 4) != 0 || header.version != PROGRAM_CACHE_VERSION ||
+        header.sourceHash != sourceHash || header.driverHash != driver ||
+        cache.size() < sizeof(header) + header.binarySize) {
+        return 0;
+    }
+
+    unsigned int program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, cache.data() + sizeof(header), header.binarySize);
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE) {
+        std::cout << "Drajver je odbio kes sejdera, prevodim iz izvora: " << path << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// Isto što i createShader, ali sa GL_PROGRAM_BINARY_RETRIEVABLE_HINT pre linkovanja (da drajver sačuva binarni oblik)
+static unsigned int linkProgram(const char* vsPath, const char* fsPath, const char* defines) {
+    unsigned int program = glCreateProgram();
+    unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vsPath, defines);
+    unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsPath, defines);
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+
+    glDetachShader(program, vertexShader);
+    glDeleteShader(vertexShader);
+    glDetachShader(program, fragmentShader);
+    glDeleteShader(fragmentShader);
+
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (success == GL_FALSE) {
+        char infoLog[512];
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "Objedinjeni sejder ima gresku! Greska: \n" << infoLog << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+static bool writeProgramBinary(const std::string& path, unsigned int program, uint64_t sourceHash, uint64_t driver) {
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return false;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.data());
+    if (length <= 0)
+        return false;
+
+    ProgramCacheHeader header = {};
+    std::memcpy(header.magic, programCacheMagic, 4);
+    header.version = PROGRAM_CACHE_VERSION;
+    header.sourceHash = sourceHash;
+    header.driverHash = driver;
+    header.binaryFormat = format;
+    header.binarySize = (uint32_t)length;
+
+    if (!writeFileAtomically(path.c_str(), &header, sizeof(header), binary.data(), (size_t)length)) {
+        std::cout << "Greska pri upisu kesa sejdera: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Kes sejdera upisan: " << path << " (" << length / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+unsigned int loadShaderProgram(const char* vsPath, const char* fsPath, const char* defines) {
+    if (!programBinarySupported())
+        return createShader(vsPath, fsPath, defines);
+
+    std::string vsSource, fsSource;
+    if (!readSource(vsPath, vsSource) || !readSource(fsPath, fsSource))
+        return createShader(vsPath, fsPath, defines);  // ispisuje grešku čitanja
+    uint64_t sourceHash = hashBytes(vsSource.data(), vsSource.size());
+    sourceHash = hashBytes(fsSource.data(), fsSource.size(), sourceHash);
+    if (defines)
+        sourceHash = hashBytes(defines, std::strlen(defines), sourceHash);
+    const uint64_t driver = driverHash();
+    const std::string path = programCachePath(vsPath, fsPath, defines);
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsedMs = [&start]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    unsigned int program = loadProgramBinary(path, sourceHash, driver);
+    if (program != 0) {
+        std::cout << "Sejder ucitan iz kesa: " << path << " (" << elapsedMs() << " ms)" << std::endl;
+        return program;
+    }
+
+    program = linkProgram(vsPath, fsPath, defines);
+    if (program == 0)
+        return 0;
+    std::cout << "Sejder preveden iz izvora (" << elapsedMs() << " ms)" << std::endl;
+    writeProgramBinary(path, program, sourceHash, driver);
+    return program;
+}
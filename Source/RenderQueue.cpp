@@ -0,0 +1,72 @@
+#include "../Header/RenderQueue.h"
+#include "../Header/Transform.h"
+
+#include <cstring>
+
+// Pozitivni float-ovi se kao neoznačeni celi brojevi porede isto kao brojevi
+static uint32_t depthBits(float depth) {
+    if (!(depth > 0.0f))
+        return 0;
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits;
+}
+
+uint64_t renderSortKey(const DrawItem& item, float depth) {
+    const uint64_t pass = item.pass & 0xF;
+    const uint64_t state = ((uint64_t)(item.program & 0xF) << 24) | ((uint64_t)(item.state & 0xF) << 20) |
+                           ((uint64_t)(item.vao & 0xFF) << 12) | (uint64_t)(item.material & 0xFFF);
+    if (item.pass == RENDER_PASS_TRANSPARENT)
+        return (pass << 60) | ((uint64_t)(~depthBits(depth)) << 28) | state;
+    return (pass << 60) | (state << 32) | depthBits(depth);
+}
+
+void RenderQueue::begin(const glm::vec3& camera) {
+    cameraPos = camera;
+    transforms.clear();
+    items.clear();
+    order.clear();
+}
+
+uint32_t RenderQueue::addTransform(const glm::mat4& model) {
+    return addTransform(model, normalMatrix(model));
+}
+
+uint32_t RenderQueue::addTransform(const glm::mat4& model, const glm::mat3& normal) {
+    DrawTransform transform;
+    transform.model = model;
+    transform.normal = normal;
+    transform.depth = glm::length(glm::vec3(model[3]) - cameraPos);
+    transforms.push_back(transform);
+    return (uint32_t)transforms.size() - 1;
+}
+
+void RenderQueue::submit(const DrawItem& item) {
+    order.push_back(SortEntry{ renderSortKey(item, transforms[item.transform].depth), (uint32_t)items.size() });
+    items.push_back(item);
+}
+
+void RenderQueue::sort() {
+    // LSD radix po bajtovima; bajt koji je isti za sve ključeve (česti slučaj: nekorišćeni bitovi programa,
+    // prolaza, dubine providnih...) se preskače
+    const size_t count = order.size();
+    if (count < 2)
+        return;
+    scratch.resize(count);
+    for (int shift = 0; shift < 64; shift += 8) {
+        size_t histogram[256] = {};
+        for (const SortEntry& entry : order)
+            ++histogram[(entry.key >> shift) & 0xFF];
+        if (histogram[(order[0].key >> shift) & 0xFF] == count)
+            continue;
+        size_t offset = 0;
+        for (size_t& bucket : histogram) {
+            size_t bucketCount = bucket;
+            bucket = offset;
+            offset += bucketCount;
+        }
+        for (const SortEntry& entry : order)
+            scratch[histogram[(entry.key >> shift) & 0xFF]++] = entry;
+        order.swap(scratch);
+    }
+}
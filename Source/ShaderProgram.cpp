@@ -0,0 +1,168 @@
+#include "../Header/ShaderProgram.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <iostream>
+#include <cstring>
+#include <utility>
+
+// Veličina jednog elementa u bajtovima; 0 za tipove za koje nema settera (uniforma se tada ne pamti)
+static unsigned int uniformTypeSize(GLenum type) {
+    switch (type) {
+    case GL_FLOAT: case GL_INT: case GL_BOOL: return 4;
+    case GL_FLOAT_VEC2: return 8;
+    case GL_FLOAT_VEC3: return 12;
+    case GL_FLOAT_VEC4: return 16;
+    case GL_FLOAT_MAT3: return 36;
+    case GL_FLOAT_MAT4: return 64;
+    case GL_SAMPLER_1D: case GL_SAMPLER_2D: case GL_SAMPLER_3D: case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_2D_SHADOW: case GL_SAMPLER_2D_ARRAY: case GL_SAMPLER_BUFFER:
+    case GL_INT_SAMPLER_2D: case GL_UNSIGNED_INT_SAMPLER_2D:
+        return 4;
+    default: return 0;
+    }
+}
+
+// int setter važi i za bool i sampler uniforme (glUniform1i)
+static bool typeMatches(GLenum declared, GLenum setter) {
+    if (declared == setter)
+        return true;
+    return setter == GL_INT && declared != GL_FLOAT && uniformTypeSize(declared) == 4;
+}
+
+ShaderProgram::ShaderProgram(unsigned int program) : program(program) {
+    reflect();
+}
+
+ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept {
+    *this = std::move(other);
+}
+
+ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept {
+    if (this != &other) {
+        program = other.program;
+        uniforms = std::move(other.uniforms);
+        values = std::move(other.values);
+        uploads = other.uploads;
+        skipped = other.skipped;
+        other.program = 0;
+        other.uniforms.clear();
+        other.values.clear();
+    }
+    return *this;
+}
+
+void ShaderProgram::reflect() {
+    uniforms.clear();
+    values.clear();
+    if (program == 0)
+        return;
+
+    GLint count = 0, maxNameLength = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+    std::vector<char> nameBuffer(maxNameLength > 0 ? maxNameLength : 1);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, (GLuint)i, (GLsizei)nameBuffer.size(), &length, &arraySize, &type, nameBuffer.data());
+        Uniform entry;
+        entry.name.assign(nameBuffer.data(), length);
+        // Uniforme iz uniform blokova nemaju lokaciju (-1); one se ne postavljaju preko glUniform*
+        entry.location = glGetUniformLocation(program, entry.name.c_str());
+        if (entry.location < 0)
+            continue;
+        if (entry.name.size() > 3 && entry.name.compare(entry.name.size() - 3, 3, "[0]") == 0)
+            entry.name.resize(entry.name.size() - 3);
+        entry.type = type;
+        entry.size = uniformTypeSize(type);
+        entry.offset = (unsigned int)values.size();
+        values.resize(values.size() + entry.size);
+        uniforms.push_back(std::move(entry));
+    }
+}
+
+void ShaderProgram::use() const {
+    glUseProgram(program);
+}
+
+void ShaderProgram::destroy() {
+    if (program != 0)
+        glDeleteProgram(program);
+    program = 0;
+    uniforms.clear();
+    values.clear();
+}
+
+UniformHandle ShaderProgram::uniform(const char* name) const {
+    for (size_t i = 0; i < uniforms.size(); ++i) {
+        if (uniforms[i].name == name)
+            return (UniformHandle)i;
+    }
+    return INVALID_UNIFORM_HANDLE;
+}
+
+bool ShaderProgram::bindUniformBlock(const char* blockName, unsigned int binding) const {
+    GLuint index = program != 0 ? glGetUniformBlockIndex(program, blockName) : GL_INVALID_INDEX;
+    if (index == GL_INVALID_INDEX)
+        return false;
+    glUniformBlockBinding(program, index, binding);
+    return true;
+}
+
+bool ShaderProgram::changed(UniformHandle handle, unsigned int type, const void* value, size_t size) {
+    if (handle < 0 || handle >= (UniformHandle)uniforms.size())
+        return false;
+    Uniform& entry = uniforms[handle];
+    if (!typeMatches(entry.type, type) || entry.size != size) {
+        if (!entry.typeErrorReported)
+            std::cout << "Uniforma " << entry.name << " je drugog tipa od vrednosti koja se postavlja" << std::endl;
+        entry.typeErrorReported = true;
+        return false;
+    }
+    unsigned char* stored = &values[entry.offset];
+    if (entry.known && std::memcmp(stored, value, size) == 0) {
+        ++skipped;
+        return false;
+    }
+    std::memcpy(stored, value, size);
+    entry.known = true;
+    ++uploads;
+    return true;
+}
+
+void ShaderProgram::set(UniformHandle handle, int value) {
+    if (changed(handle, GL_INT, &value, sizeof(value)))
+        glUniform1i(uniforms[handle].location, value);
+}
+
+void ShaderProgram::set(UniformHandle handle, float value) {
+    if (changed(handle, GL_FLOAT, &value, sizeof(value)))
+        glUniform1f(uniforms[handle].location, value);
+}
+
+void ShaderProgram::set(UniformHandle handle, const glm::vec2& value) {
+    if (changed(handle, GL_FLOAT_VEC2, glm::value_ptr(value), sizeof(value)))
+        glUniform2fv(uniforms[handle].location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::set(UniformHandle handle, const glm::vec3& value) {
+    if (changed(handle, GL_FLOAT_VEC3, glm::value_ptr(value), sizeof(value)))
+        glUniform3fv(uniforms[handle].location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::set(UniformHandle handle, const glm::vec4& value) {
+    if (changed(handle, GL_FLOAT_VEC4, glm::value_ptr(value), sizeof(value)))
+        glUniform4fv(uniforms[handle].location, 1, glm::value_ptr(value));
+}
+
+void ShaderProgram::set(UniformHandle handle, const glm::mat3& value) {
+    if (changed(handle, GL_FLOAT_MAT3, glm::value_ptr(value), sizeof(value)))
+        glUniformMatrix3fv(uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void ShaderProgram::set(UniformHandle handle, const glm::mat4& value) {
+    if (changed(handle, GL_FLOAT_MAT4, glm::value_ptr(value), sizeof(value)))
+        glUniformMatrix4fv(uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
+}
@@ -0,0 +1,68 @@
+#include "../Header/ShaderVariants.h"
+#include "../Header/ProgramCache.h"
+
+#include <iostream>
+
+const char* shaderVariantName(ShaderVariant variant) {
+    switch (variant) {
+    case SHADER_VARIANT_OPAQUE_LIT: return "opaque-lit";
+    case SHADER_VARIANT_OPAQUE_LIT_TEXTURED: return "opaque-lit-textured";
+    case SHADER_VARIANT_TRANSPARENT_LIT: return "transparent-lit";
+    case SHADER_VARIANT_UNLIT_OVERLAY: return "unlit-overlay";
+    case SHADER_VARIANT_OPAQUE_LIT_INSTANCED: return "opaque-lit-instanced";
+    case SHADER_VARIANT_OPAQUE_LIT_MULTIDRAW: return "opaque-lit-multidraw";
+    case SHADER_VARIANT_TRANSPARENT_LIT_MULTIDRAW: return "transparent-lit-multidraw";
+    default: return "?";
+    }
+}
+
+const char* shaderVariantDefines(ShaderVariant variant) {
+    switch (variant) {
+    case SHADER_VARIANT_OPAQUE_LIT_TEXTURED: return "#define USE_TEXTURE\n";
+    case SHADER_VARIANT_TRANSPARENT_LIT: return "#define TRANSPARENT\n";
+    case SHADER_VARIANT_UNLIT_OVERLAY: return "#define UNLIT\n#define USE_TEXTURE\n";
+    case SHADER_VARIANT_OPAQUE_LIT_INSTANCED: return "#define INSTANCED\n";
+    case SHADER_VARIANT_OPAQUE_LIT_MULTIDRAW: return "#define MULTI_DRAW\n";
+    case SHADER_VARIANT_TRANSPARENT_LIT_MULTIDRAW: return "#define TRANSPARENT\n#define MULTI_DRAW\n";
+    default: return "";
+    }
+}
+
+ShaderVariantCache::ShaderVariantCache(const char* vsPath, const char* fsPath) : vsPath(vsPath), fsPath(fsPath) {}
+
+ShaderProgram& ShaderVariantCache::get(ShaderVariant variant) {
+    if (!isLoaded[variant]) {
+        isLoaded[variant] = true;
+        std::cout << "Sejder varijanta " << shaderVariantName(variant) << std::endl;
+        programs[variant] = ShaderProgram(loadShaderProgram(vsPath.c_str(), fsPath.c_str(), shaderVariantDefines(variant)));
+    }
+    return programs[variant];
+}
+
+size_t ShaderVariantCache::loadedCount() const {
+    size_t count = 0;
+    for (bool loaded : isLoaded)
+        count += loaded ? 1 : 0;
+    return count;
+}
+
+size_t ShaderVariantCache::uploadCount() const {
+    size_t count = 0;
+    for (const ShaderProgram& program : programs)
+        count += program.uploadCount();
+    return count;
+}
+
+size_t ShaderVariantCache::skippedCount() const {
+    size_t count = 0;
+    for (const ShaderProgram& program : programs)
+        count += program.skippedCount();
+    return count;
+}
+
+void ShaderVariantCache::destroy() {
+    for (int i = 0; i < SHADER_VARIANT_COUNT; ++i) {
+        programs[i].destroy();
+        isLoaded[i] = false;
+    }
+}
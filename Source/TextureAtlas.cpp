@@ -0,0 +1,249 @@
+#include "../Header/TextureAtlas.h"
+#include "../Header/ImageOps.h"
+#include "../Header/Util.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+// Poravnanje mesta u atlasu; 4 = 2^2, pa nivoi 0..2 ostaju unutar gutter-a svog sprajta
+static const int ATLAS_ALIGNMENT = 4;
+static const int ATLAS_MAX_MIP_LEVEL = 2;
+
+// Skyline: gornja ivica zauzetog dela kao niz horizontalnih segmenata; novi pravougaonik ide na mesto gde mu je
+// gornja ivica najniža (pa najuži segment), što dobro pakuje sprajtove sortirane po visini
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height) : width(width), height(height) {
+        nodes.push_back({ 0, 0, width });
+    }
+
+    bool insert(int rectWidth, int rectHeight, int& outX, int& outY) {
+        int bestIndex = -1, bestTop = height + 1, bestWidth = width + 1;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            int y;
+            if (!fits(i, rectWidth, rectHeight, y))
+                continue;
+            int top = y + rectHeight;
+            if (top < bestTop || (top == bestTop && nodes[i].width < bestWidth)) {
+                bestIndex = (int)i;
+                bestTop = top;
+                bestWidth = nodes[i].width;
+                outX = nodes[i].x;
+                outY = y;
+            }
+        }
+        if (bestIndex < 0)
+            return false;
+        addLevel(bestIndex, outX, outY + rectHeight, rectWidth);
+        return true;
+    }
+
+private:
+    struct Node {
+        int x, y, width;
+    };
+
+    // Visina na kojoj pravougaonik počinje ako mu je levi kraj na početku segmenta index
+    bool fits(size_t index, int rectWidth, int rectHeight, int& y) const {
+        int x = nodes[index].x;
+        if (x + rectWidth > width)
+            return false;
+        y = 0;
+        int remaining = rectWidth;
+        for (size_t i = index; remaining > 0; ++i) {
+            y = std::max(y, nodes[i].y);
+            if (y + rectHeight > height)
+                return false;
+            remaining -= nodes[i].width;
+        }
+        return true;
+    }
+
+    void addLevel(int index, int x, int y, int rectWidth) {
+        nodes.insert(nodes.begin() + index, { x, y, rectWidth });
+        // Segmenti desno koje novi delimično ili potpuno prekriva
+        for (size_t i = index + 1; i < nodes.size(); ) {
+            int covered = nodes[index].x + nodes[index].width - nodes[i].x;
+            if (covered <= 0)
+                break;
+            if (covered >= nodes[i].width) {
+                nodes.erase(nodes.begin() + i);
+                continue;
+            }
+            nodes[i].x += covered;
+            nodes[i].width -= covered;
+            break;
+        }
+        // Spajanje susednih segmenata iste visine
+        for (size_t i = 0; i + 1 < nodes.size(); ) {
+            if (nodes[i].y == nodes[i + 1].y) {
+                nodes[i].width += nodes[i + 1].width;
+                nodes.erase(nodes.begin() + i + 1);
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+
+    int width, height;
+    std::vector<Node> nodes;
+};
+
+static int alignUp(int value) {
+    return (value + ATLAS_ALIGNMENT - 1) / ATLAS_ALIGNMENT * ATLAS_ALIGNMENT;
+}
+
+struct SpriteImage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;  // RGBA8
+};
+
+static bool loadSpriteImage(const std::string& path, int maxSize, SpriteImage& sprite) {
+    DecodedImage image;
+    if (!decodeTextureImage(path.c_str(), image))
+        return false;
+    std::vector<unsigned char> rgba((size_t)image.width * image.height * 4);
+    expandToRGBA(image.pixels, image.channels, (size_t)image.width * image.height, rgba.data());
+
+    int longer = std::max(image.width, image.height);
+    if (longer <= maxSize) {
+        sprite.width = image.width;
+        sprite.height = image.height;
+        sprite.pixels = std::move(rgba);
+        return true;
+    }
+    // Na ekranu sprajt ionako nije veći od maxSize; smanjivanje čuva atlas malim
+    sprite.width = std::max(1, image.width * maxSize / longer);
+    sprite.height = std::max(1, image.height * maxSize / longer);
+    sprite.pixels.resize((size_t)sprite.width * sprite.height * 4);
+    resizeAreaRGBA(rgba.data(), image.width, image.height, sprite.pixels.data(), sprite.width, sprite.height);
+    return true;
+}
+
+// Kopira sprajt i popunjava gutter ponavljanjem ivičnih piksela
+static void blitWithGutter(const SpriteImage& sprite, int padding, AtlasImage& atlas, int x, int y) {
+    for (int row = -padding; row < sprite.height + padding; ++row) {
+        int targetY = y + row;
+        if (targetY < 0 || targetY >= atlas.height)
+            continue;
+        const unsigned char* source = &sprite.pixels[(size_t)std::min(std::max(row, 0), sprite.height - 1) * sprite.width * 4];
+        unsigned char* target = &atlas.pixels[((size_t)targetY * atlas.width + x) * 4];
+        std::memcpy(target, source, (size_t)sprite.width * 4);
+        for (int column = 1; column <= padding; ++column) {
+            if (x - column >= 0)
+                std::memcpy(target - column * 4, source, 4);
+            if (x + sprite.width - 1 + column < atlas.width)
+                std::memcpy(target + (sprite.width - 1 + column) * 4, source + (sprite.width - 1) * 4, 4);
+        }
+    }
+}
+
+bool buildTextureAtlas(const std::vector<std::string>& paths, const AtlasOptions& options, AtlasImage& atlas) {
+    std::vector<SpriteImage> images(paths.size());
+    size_t area = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!loadSpriteImage(paths[i], options.maxSpriteSize, images[i]))
+            return false;
+        area += (size_t)alignUp(images[i].width + 2 * options.padding) * alignUp(images[i].height + 2 * options.padding);
+    }
+
+    // Pakovanje po opadajućoj visini, pa po širini
+    std::vector<size_t> order(paths.size());
+    for (size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+        if (images[a].height != images[b].height)
+            return images[a].height > images[b].height;
+        return images[a].width > images[b].width;
+    });
+
+    // Najmanji atlas (stranice stepen dvojke, širina = visina ili 2 * visina) u koji sve staje;
+    // počinje se od ukupne površine da se ne probaju očigledno mali
+    int atlasWidth = 64, atlasHeight = 64;
+    auto grow = [&atlasWidth, &atlasHeight]() {
+        if (atlasWidth == atlasHeight) atlasWidth *= 2;
+        else atlasHeight *= 2;
+    };
+    while ((size_t)atlasWidth * atlasHeight < area)
+        grow();
+    std::vector<int> slotX(paths.size()), slotY(paths.size());
+    for (; atlasWidth <= options.maxAtlasSize; grow()) {
+        SkylinePacker packer(atlasWidth, atlasHeight);
+        bool packed = true;
+        for (size_t index : order) {
+            int slotWidth = alignUp(images[index].width + 2 * options.padding);
+            int slotHeight = alignUp(images[index].height + 2 * options.padding);
+            if (!packer.insert(slotWidth, slotHeight, slotX[index], slotY[index])) {
+                packed = false;
+                break;
+            }
+        }
+        if (packed)
+            break;
+    }
+    if (atlasWidth > options.maxAtlasSize) {
+        std::cout << "Sprajtovi ne staju u atlas " << options.maxAtlasSize << "x" << options.maxAtlasSize << std::endl;
+        return false;
+    }
+
+    atlas.width = atlasWidth;
+    atlas.height = atlasHeight;
+    atlas.pixels.assign((size_t)atlasWidth * atlasHeight * 4, 0);
+    atlas.sprites.resize(paths.size());
+    size_t usedArea = 0;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        AtlasSprite& sprite = atlas.sprites[i];
+        sprite.path = paths[i];
+        sprite.x = slotX[i] + options.padding;
+        sprite.y = slotY[i] + options.padding;
+        sprite.width = images[i].width;
+        sprite.height = images[i].height;
+        sprite.u0 = (float)sprite.x / atlasWidth;
+        sprite.v0 = (float)sprite.y / atlasHeight;
+        sprite.u1 = (float)(sprite.x + sprite.width) / atlasWidth;
+        sprite.v1 = (float)(sprite.y + sprite.height) / atlasHeight;
+        blitWithGutter(images[i], options.padding, atlas, sprite.x, sprite.y);
+        usedArea += (size_t)sprite.width * sprite.height;
+    }
+    std::cout << "Atlas " << atlasWidth << "x" << atlasHeight << ": " << paths.size() << " sprajtova, popunjenost "
+              << usedArea * 100 / ((size_t)atlasWidth * atlasHeight) << "%" << std::endl;
+    return true;
+}
+
+unsigned int createAtlasTexture(const AtlasImage& atlas) {
+    if (atlas.pixels.empty())
+        return 0;
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize > 0 && (atlas.width > maxTextureSize || atlas.height > maxTextureSize)) {
+        std::cout << "Atlas je veci od GL_MAX_TEXTURE_SIZE (" << maxTextureSize << ")" << std::endl;
+        return 0;
+    }
+
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, atlas.width, atlas.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlas.pixels.data());
+    // Mip nivoi na CPU tačnim 2x2 box filterom (glGenerateMipmap bira filter po drajveru), pa poravnanje i gutter
+    // garantuju da nivoi 1..ATLAS_MAX_MIP_LEVEL ne mešaju susedne sprajtove
+    std::vector<unsigned char> level = atlas.pixels, next;
+    int width = atlas.width, height = atlas.height;
+    for (int i = 1; i <= ATLAS_MAX_MIP_LEVEL && (width > 1 || height > 1); ++i) {
+        const int nextWidth = std::max(1, width / 2), nextHeight = std::max(1, height / 2);
+        next.resize((size_t)nextWidth * nextHeight * 4);
+        downsample2xRGBA(level.data(), width, height, next.data());
+        glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, nextWidth, nextHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, next.data());
+        level.swap(next);
+        width = nextWidth;
+        height = nextHeight;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, ATLAS_MAX_MIP_LEVEL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
@@ -0,0 +1,390 @@
+#include "../Header/TextureCompiler.h"
+#include "../Header/Hash.h"
+#include "../Header/MappedFile.h"
+#include "../Header/Util.h"
+#include "../Header/ImageOps.h"
+
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <cmath>
+
+// DDS zaglavlje (posle "DDS " magičnog broja), tačno 124 bajta kao u DirectX dokumentaciji.
+// U reserved1 (koji čitači ignorišu) čuvamo oznaku, verziju kodera i hash izvorne slike za proveru zastarelosti.
+struct DDSPixelFormat {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t fourCC;
+    uint32_t rgbBitCount;
+    uint32_t rBitMask, gBitMask, bBitMask, aBitMask;
+};
+
+struct DDSHeader {
+    uint32_t size;
+    uint32_t flags;
+    uint32_t height;
+    uint32_t width;
+    uint32_t pitchOrLinearSize;
+    uint32_t depth;
+    uint32_t mipMapCount;
+    uint32_t reserved1[11];
+    DDSPixelFormat pixelFormat;
+    uint32_t caps, caps2, caps3, caps4;
+    uint32_t reserved2;
+};
+
+static_assert(sizeof(DDSHeader) == 124, "DDS zaglavlje mora imati 124 bajta");
+
+static const char ddsMagic[4] = { 'D', 'D', 'S', ' ' };
+
+static uint32_t fourCC(char a, char b, char c, char d) {
+    return (uint32_t)(unsigned char)a | ((uint32_t)(unsigned char)b << 8) | ((uint32_t)(unsigned char)c << 16) | ((uint32_t)(unsigned char)d << 24);
+}
+
+static const uint32_t DDSD_CAPS = 0x1, DDSD_HEIGHT = 0x2, DDSD_WIDTH = 0x4, DDSD_PIXELFORMAT = 0x1000;
+static const uint32_t DDSD_MIPMAPCOUNT = 0x20000, DDSD_LINEARSIZE = 0x80000;
+static const uint32_t DDPF_FOURCC = 0x4;
+static const uint32_t DDSCAPS_COMPLEX = 0x8, DDSCAPS_TEXTURE = 0x1000, DDSCAPS_MIPMAP = 0x400000;
+
+// reserved1[0..3]: oznaka, verzija, hash slike (niža pa viša polovina)
+static const uint32_t compiledTextureTag = fourCC('K', 'T', 'E', 'X');
+
+// Slika u RGBA8, redovi od dna ka vrhu
+struct RGBAImage {
+    int width = 0, height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+std::string compiledTexturePath(const char* imagePath) {
+    return std::string(imagePath) + ".dds";
+}
+
+static size_t blockBytes(bool hasAlpha) {
+    return hasAlpha ? 16 : 8;
+}
+
+static size_t compressedLevelSize(int width, int height, size_t bytesPerBlock) {
+    return (size_t)((width + 3) / 4) * ((height + 3) / 4) * bytesPerBlock;
+}
+
+// Kanali kao kod glTexImage2D sa GL_RED/GL_RG/GL_RGB, da prevedena tekstura izgleda isto kao neprevedena
+static void toRGBA(const DecodedImage& image, RGBAImage& out) {
+    out.width = image.width;
+    out.height = image.height;
+    out.pixels.resize((size_t)image.width * image.height * 4);
+    expandToRGBA(image.pixels, image.channels, (size_t)image.width * image.height, out.pixels.data());
+}
+
+static uint16_t packRGB565(const float color[3]) {
+    int r = (int)(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+    int g = (int)(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f + 0.5f);
+    int b = (int)(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static void unpackRGB565(uint16_t packed, int color[3]) {
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// BC1 blok u 4-bojnom režimu (c0 > c1). Krajnje boje leže na glavnoj osi boja bloka (power iteration nad
+// kovarijansom), malo uvučene ka sredini da bi se smanjila greška kvantizacije na 565.
+static void encodeColorBlock(const unsigned char block[16][4], unsigned char* out) {
+    float mean[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 3; ++c)
+            mean[c] += block[i][c];
+    for (int c = 0; c < 3; ++c)
+        mean[c] /= 16.0f;
+
+    float cov[6] = { 0, 0, 0, 0, 0, 0 };  // xx, xy, xz, yy, yz, zz
+    for (int i = 0; i < 16; ++i) {
+        float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+    float axis[3] = { 1.0f, 1.0f, 1.0f };
+    for (int iteration = 0; iteration < 8; ++iteration) {
+        float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        float length = std::max(std::max(std::fabs(x), std::fabs(y)), std::fabs(z));
+        if (length < 1e-6f)
+            break;  // jednobojan blok – osa nije bitna
+        axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+    }
+
+    float minProjection = 1e30f, maxProjection = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        float projection = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+        minProjection = std::min(minProjection, projection);
+        maxProjection = std::max(maxProjection, projection);
+    }
+    float axisLengthSq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float inset = (maxProjection - minProjection) / 16.0f;
+    float high[3], low[3];
+    for (int c = 0; c < 3; ++c) {
+        high[c] = mean[c] + axis[c] * (maxProjection - inset) / axisLengthSq;
+        low[c] = mean[c] + axis[c] * (minProjection + inset) / axisLengthSq;
+    }
+
+    uint16_t c0 = packRGB565(high), c1 = packRGB565(low);
+    if (c0 < c1)
+        std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    }
+    // Jednake krajnje boje: svi indeksi 0 (c0 == c1 bi inače uključio 3-bojni režim sa providnom bojom 3)
+
+    std::memcpy(out, &c0, 2);
+    std::memcpy(out + 2, &c1, 2);
+    std::memcpy(out + 4, &indices, 4);
+}
+
+// BC3 alfa blok: a0 = max, a1 = min (8 nivoa), 3-bitni indeksi
+static void encodeAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, (int)block[i][3]);
+        a1 = std::min(a1, (int)block[i][3]);
+    }
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8] = { a0, a1 };
+        for (int i = 2; i < 8; ++i)
+            palette[i] = ((8 - i) * a0 + (i - 1) * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestError = 1 << 30;
+            for (int p = 0; p < 8; ++p) {
+                int error = std::abs(block[i][3] - palette[p]);
+                if (error < bestError) { bestError = error; best = p; }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int i = 0; i < 6; ++i)
+        out[2 + i] = (unsigned char)(indices >> (8 * i));
+}
+
+// Kompresuje jedan nivo; blokovi na ivici ponavljaju poslednji red/kolonu
+static void compressLevel(const RGBAImage& image, bool hasAlpha, unsigned char* out) {
+    const int blocksX = (image.width + 3) / 4, blocksY = (image.height + 3) / 4;
+    unsigned char block[16][4];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int y = 0; y < 4; ++y) {
+                int sy = std::min(by * 4 + y, image.height - 1);
+                for (int x = 0; x < 4; ++x) {
+                    int sx = std::min(bx * 4 + x, image.width - 1);
+                    std::memcpy(block[y * 4 + x], &image.pixels[((size_t)sy * image.width + sx) * 4], 4);
+                }
+            }
+            if (hasAlpha) {
+                encodeAlphaBlock(block, out);
+                out += 8;
+            }
+            encodeColorBlock(block, out);
+            out += 8;
+        }
+    }
+}
+
+bool compileTexture(const char* imagePath) {
+    uint64_t sourceHash = hashFile(imagePath);
+    DecodedImage decoded;
+    if (sourceHash == 0 || !decodeTextureImage(imagePath, decoded))
+        return false;
+
+    RGBAImage level;
+    toRGBA(decoded, level);
+    decoded = DecodedImage();
+
+    bool hasAlpha = false;
+    for (size_t i = 3; i < level.pixels.size() && !hasAlpha; i += 4)
+        hasAlpha = level.pixels[i] != 255;
+    const size_t bytesPerBlock = blockBytes(hasAlpha);
+
+    // Ceo mip lanac do 1x1. Usrednjava se u linearnom prostoru (sRGB bi potamneo kontraste na manjim nivoima),
+    // a lanac ostaje u float-u da se greška kvantizacije ne sabira kroz nivoe
+    std::vector<unsigned char> blocks;
+    uint32_t levelCount = 0;
+    const int width = level.width, height = level.height;
+    std::vector<float> linear(level.pixels.size()), nextLinear;
+    srgbToLinearRGBA(level.pixels.data(), (size_t)width * height, linear.data());
+    while (true) {
+        size_t offset = blocks.size();
+        blocks.resize(offset + compressedLevelSize(level.width, level.height, bytesPerBlock));
+        compressLevel(level, hasAlpha, &blocks[offset]);
+        ++levelCount;
+        if (level.width == 1 && level.height == 1)
+            break;
+        int nextWidth = std::max(1, level.width / 2), nextHeight = std::max(1, level.height / 2);
+        nextLinear.resize((size_t)nextWidth * nextHeight * 4);
+        downsample2xLinearRGBA(linear.data(), level.width, level.height, nextLinear.data());
+        linear.swap(nextLinear);
+        level.width = nextWidth;
+        level.height = nextHeight;
+        level.pixels.resize(linear.size());
+        linearToSrgbRGBA(linear.data(), (size_t)nextWidth * nextHeight, level.pixels.data());
+    }
+
+    DDSHeader header = {};
+    header.size = sizeof(DDSHeader);
+    header.flags = DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE;
+    header.height = height;
+    header.width = width;
+    header.pitchOrLinearSize = (uint32_t)compressedLevelSize(width, height, bytesPerBlock);
+    header.mipMapCount = levelCount;
+    header.reserved1[0] = compiledTextureTag;
+    header.reserved1[1] = COMPILED_TEXTURE_VERSION;
+    header.reserved1[2] = (uint32_t)sourceHash;
+    header.reserved1[3] = (uint32_t)(sourceHash >> 32);
+    header.pixelFormat.size = sizeof(DDSPixelFormat);
+    header.pixelFormat.flags = DDPF_FOURCC;
+    header.pixelFormat.fourCC = hasAlpha ? fourCC('D', 'X', 'T', '5') : fourCC('D', 'X', 'T', '1');
+    header.caps = DDSCAPS_TEXTURE | DDSCAPS_MIPMAP | DDSCAPS_COMPLEX;
+
+    char fileHeader[4 + sizeof(DDSHeader)];
+    std::memcpy(fileHeader, ddsMagic, 4);
+    std::memcpy(fileHeader + 4, &header, sizeof(header));
+    std::string path = compiledTexturePath(imagePath);
+    if (!writeFileAtomically(path.c_str(), fileHeader, sizeof(fileHeader), blocks.data(), blocks.size())) {
+        std::cout << "Greska pri upisu prevedene teksture: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Tekstura prevedena: " << path << " (" << width << "x" << height << ", " << levelCount << " nivoa, "
+              << (hasAlpha ? "BC3" : "BC1") << ", " << blocks.size() / 1024 << " KB umesto "
+              << (size_t)width * height * 4 / 1024 << " KB)" << std::endl;
+    return true;
+}
+
+int runTextureCompiler(int argc, char** argv) {
+    std::vector<std::string> paths;
+    for (int i = 2; i < argc; ++i)
+        paths.push_back(argv[i]);
+    if (paths.empty()) {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator("Resources", error)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+            if (entry.is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".jpeg"))
+                paths.push_back(entry.path().generic_string());
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+    if (paths.empty()) {
+        std::cout << "Nema slika za prevodjenje" << std::endl;
+        return 1;
+    }
+
+    int failed = 0;
+    for (const std::string& path : paths) {
+        if (!compileTexture(path.c_str())) {
+            std::cout << "Tekstura nije prevedena: " << path << std::endl;
+            ++failed;
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
+
+bool readCompiledTexture(const char* imagePath, CompressedTexture& texture) {
+    MappedFile file;
+    if (!file.open(compiledTexturePath(imagePath).c_str()))
+        return false;
+
+    const char* base = file.data();
+    const size_t size = file.size();
+    DDSHeader header;
+    if (size < 4 + sizeof(DDSHeader) || std::memcmp(base, ddsMagic, 4) != 0)
+        return false;
+    std::memcpy(&header, base + 4, sizeof(header));
+
+    uint64_t storedHash = header.reserved1[2] | ((uint64_t)header.reserved1[3] << 32);
+    if (header.size != sizeof(DDSHeader) || header.reserved1[0] != compiledTextureTag ||
+        header.reserved1[1] != COMPILED_TEXTURE_VERSION || storedHash != hashFile(imagePath)) {
+        std::cout << "Prevedena tekstura je zastarela: " << imagePath << std::endl;
+        return false;
+    }
+
+    bool hasAlpha;
+    if (header.pixelFormat.fourCC == fourCC('D', 'X', 'T', '1'))
+        hasAlpha = false;
+    else if (header.pixelFormat.fourCC == fourCC('D', 'X', 'T', '5'))
+        hasAlpha = true;
+    else
+        return false;
+
+    // Nivoi i provera da svi staju u fajl
+    const size_t dataSize = size - 4 - sizeof(DDSHeader);
+    const size_t bytesPerBlock = blockBytes(hasAlpha);
+    std::vector<CompressedMipLevel> levels;
+    size_t offset = 0;
+    int width = (int)header.width, height = (int)header.height;
+    if (width <= 0 || height <= 0 || header.mipMapCount == 0 || header.mipMapCount > 32)
+        return false;
+    for (uint32_t i = 0; i < header.mipMapCount; ++i) {
+        size_t levelSize = compressedLevelSize(width, height, bytesPerBlock);
+        if (offset + levelSize > dataSize) {
+            std::cout << "Prevedena tekstura je ostecena: " << imagePath << std::endl;
+            return false;
+        }
+        levels.push_back({ width, height, offset, levelSize });
+        offset += levelSize;
+        width = std::max(1, width / 2);
+        height = std::max(1, height / 2);
+    }
+
+    texture.data = base + 4 + sizeof(DDSHeader);
+    texture.dataSize = dataSize;
+    texture.format = hasAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    texture.levels = std::move(levels);
+    texture.file = std::move(file);
+    return true;
+}
+
+bool compressedTexturesSupported() {
+    return GLEW_EXT_texture_compression_s3tc != 0;
+}
+
+unsigned int createCompressedTexture(const CompressedTexture& texture, const char* pixelData) {
+    unsigned int id;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+    for (size_t i = 0; i < texture.levels.size(); ++i) {
+        const CompressedMipLevel& level = texture.levels[i];
+        // Bez pixelData offset se tumači kao pomeraj u vezanom PBO-u
+        const void* source = pixelData ? (const void*)(pixelData + level.offset) : (const void*)level.offset;
+        glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, texture.format, level.width, level.height, 0, (GLsizei)level.size, source);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)texture.levels.size() - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return id;
+}
@@ -0,0 +1,389 @@
+#include "../Header/TextureStreamer.h"
+#include "../Header/Hash.h"
+
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+
+// Dovoljno za nekoliko tekstura u letu; veći broj samo troši memoriju jer se upload ionako deli po frejmovima
+static const size_t MAX_PIXEL_BUFFERS = 4;
+
+TextureStreamer::TextureStreamer(unsigned int workerCount, size_t uploadBudget)
+    : uploadBudget(uploadBudget), useCompressed(compressedTexturesSupported()) {
+    if (workerCount == 0)
+        workerCount = 1;
+    for (unsigned int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&TextureStreamer::workerLoop, this);
+}
+
+TextureStreamer::~TextureStreamer() {
+    // GL objekte briše shutdown() dok je kontekst živ; ovde se samo zaustavljaju niti
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    decodeSignal.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+TextureHandle TextureStreamer::request(const char* filePath) {
+    // Ista putanja: ista tekstura, samo još jedna referenca
+    auto pathIt = byPath.find(filePath);
+    if (pathIt != byPath.end()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++entries[pathIt->second]->refCount;
+        return pathIt->second;
+    }
+
+    std::unique_ptr<Entry> entry(new Entry());
+    entry->path = filePath;
+    entry->requestTime = glfwGetTime();
+    Entry* pending = entry.get();
+    entries.push_back(std::move(entry));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decodeQueue.push_back(pending);
+    }
+    decodeSignal.notify_one();
+    const TextureHandle handle = (TextureHandle)(entries.size() - 1);
+    byPath[filePath] = handle;
+    return handle;
+}
+
+void TextureStreamer::release(TextureHandle handle) {
+    if (handle < 0 || (size_t)handle >= entries.size())
+        return;
+    Entry& entry = *entries[handle];
+    std::lock_guard<std::mutex> lock(mutex);
+    if (entry.refCount <= 0 || --entry.refCount > 0)
+        return;
+    byPath.erase(entry.path);
+    if (entry.state == State::Shared) {
+        Entry& sharedOwner = *entry.shared;
+        entry.state = State::Released;
+        entry.shared = nullptr;
+        --sharedOwner.sharedCount;
+        releaseOwner(sharedOwner);
+    } else {
+        releaseOwner(entry);
+    }
+}
+
+void TextureStreamer::releaseOwner(Entry& entry) {
+    if (entry.refCount > 0 || entry.sharedCount > 0 || entry.state == State::Released)
+        return;
+    if (entry.contentHash != 0) {
+        auto contentIt = byContent.find(entry.contentHash);
+        if (contentIt != byContent.end() && contentIt->second == &entry)
+            byContent.erase(contentIt);
+    }
+    if (entry.state == State::Ready || entry.state == State::Failed) {
+        if (entry.texture)
+            glDeleteTextures(1, &entry.texture);
+        entry.texture = 0;
+        entry.state = State::Released;
+    } else {
+        // Dekodiranje ili upload je u toku; tekstura se briše u pollFences kad stigne
+        entry.orphaned = true;
+    }
+}
+
+void TextureStreamer::workerLoop() {
+    while (true) {
+        Entry* entry;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            decodeSignal.wait(lock, [this]() { return stopping || !decodeQueue.empty(); });
+            if (stopping)
+                return;
+            entry = decodeQueue.front();
+            decodeQueue.pop_front();
+            // Sve reference vraćene dok je čekao u redu: ne deli se, ne dekodira i ne dobija sharedCount
+            if (entry->orphaned || entry->refCount == 0) {
+                entry->orphaned = false;
+                entry->state = State::Released;
+                continue;
+            }
+        }
+        // Isti sadržaj kao već zahtevana tekstura: nema dekodiranja ni nove GL teksture
+        const uint64_t contentHash = hashFile(entry->path);
+        if (contentHash != 0) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (entry->orphaned || entry->refCount == 0) {
+                entry->orphaned = false;
+                entry->state = State::Released;
+                continue;
+            }
+            auto contentIt = byContent.find(contentHash);
+            if (contentIt != byContent.end() && contentIt->second->state != State::Failed) {
+                entry->shared = contentIt->second;
+                entry->state = State::Shared;
+                ++entry->shared->sharedCount;
+                continue;
+            }
+            entry->contentHash = contentHash;
+            byContent[contentHash] = entry;
+        }
+
+        // Dekodiranje van lock-a; Entry se ne pomera (unique_ptr), a glavna nit ga ne dira dok je u stanju Decoding
+        DecodedImage image;
+        CompressedTexture compressed;
+        bool decoded = (useCompressed && readCompiledTexture(entry->path.c_str(), compressed)) ||
+                       decodeTextureImage(entry->path.c_str(), image);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entry->orphaned) {
+            // Pušten tokom dekodiranja: nema koga da čeka upload
+            entry->orphaned = false;
+            entry->state = State::Released;
+            continue;
+        }
+        entry->image = std::move(image);
+        entry->compressed = std::move(compressed);
+        entry->state = decoded ? State::Decoded : State::Failed;
+        if (decoded)
+            decodedQueue.push_back(entry);
+    }
+}
+
+void TextureStreamer::pollFences() {
+    for (PixelBuffer& pixelBuffer : pixelBuffers) {
+        if (!pixelBuffer.entry)
+            continue;
+        // Timeout 0: samo provera, nikad čekanje
+        GLenum status = glClientWaitSync(pixelBuffer.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+            continue;
+        glDeleteSync(pixelBuffer.fence);
+        pixelBuffer.fence = nullptr;
+        Entry& entry = *pixelBuffer.entry;
+        pixelBuffer.entry = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            entry.state = State::Ready;
+            if (entry.orphaned) {
+                releaseOwner(entry);
+                continue;
+            }
+        }
+        std::cout << "Tekstura spremna: " << entry.path << " (" << (glfwGetTime() - entry.requestTime) * 1000.0 << " ms od zahteva)" << std::endl;
+    }
+}
+
+size_t TextureStreamer::uploadSize(const Entry& entry) {
+    if (!entry.compressed.levels.empty()) {
+        const CompressedMipLevel& last = entry.compressed.levels.back();
+        return last.offset + last.size;
+    }
+    return (size_t)entry.image.width * entry.image.height * entry.image.channels;
+}
+
+bool TextureStreamer::uploadEntry(Entry& entry) {
+    const DecodedImage& image = entry.image;
+    const CompressedTexture& compressed = entry.compressed;
+    size_t size = uploadSize(entry);
+
+    // Slobodan PBO: prvo onaj koji je već dovoljno veliki, inače bilo koji slobodan (ili novi dok ima mesta)
+    PixelBuffer* target = nullptr;
+    for (PixelBuffer& pixelBuffer : pixelBuffers) {
+        if (pixelBuffer.entry) continue;
+        if (pixelBuffer.capacity >= size) { target = &pixelBuffer; break; }
+        if (!target) target = &pixelBuffer;
+    }
+    if (!target && pixelBuffers.size() < MAX_PIXEL_BUFFERS) {
+        pixelBuffers.emplace_back();
+        target = &pixelBuffers.back();
+        glGenBuffers(1, &target->buffer);
+    }
+    if (!target)
+        return false;  // svi PBO-i su još u letu – pokušava se sledećeg frejma
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, target->buffer);
+    if (target->capacity < size) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        target->capacity = size;
+    }
+    // INVALIDATE: drajver ne mora da čuva stari sadržaj ni da čeka prethodno čitanje iz bafera
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        std::cout << "Greska pri mapiranju PBO-a za teksturu: " << entry.path << std::endl;
+        std::lock_guard<std::mutex> lock(mutex);
+        entry.state = State::Failed;
+        entry.image = DecodedImage();
+        entry.compressed = CompressedTexture();
+        return true;
+    }
+
+    if (!compressed.levels.empty()) {
+        // Svi mip nivoi jednim kopiranjem; glCompressedTexImage2D ih čita sa offset-a u PBO-u
+        std::memcpy(mapped, compressed.data, size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        entry.texture = createCompressedTexture(compressed, nullptr);
+        entry.width = compressed.levels[0].width;
+        entry.height = compressed.levels[0].height;
+        entry.bytes = size;
+        entry.compressedFormat = true;
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        finishUpload(entry, *target);
+        return true;
+    }
+
+    std::memcpy(mapped, image.pixels, size);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    GLint format;
+    switch (image.channels) {
+    case 1: format = GL_RED; break;
+    case 2: format = GL_RG; break;
+    case 3: format = GL_RGB; break;
+    default: format = GL_RGBA; break;
+    }
+
+    glGenTextures(1, &entry.texture);
+    glBindTexture(GL_TEXTURE_2D, entry.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // Redovi su gusto pakovani (RGB slike neparne širine nisu poravnate na 4 bajta)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, image.width, image.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.width, image.height, format, GL_UNSIGNED_BYTE, (void*)0);  // iz PBO-a
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    entry.width = image.width;
+    entry.height = image.height;
+    entry.bytes = (size_t)image.width * image.height * (image.channels == 3 ? 4 : image.channels);
+
+    finishUpload(entry, *target);
+    return true;
+}
+
+void TextureStreamer::finishUpload(Entry& entry, PixelBuffer& target) {
+    target.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    target.entry = &entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entry.state = State::Uploading;
+    }
+    // Pikseli su u PBO-u
+    entry.image = DecodedImage();
+    entry.compressed = CompressedTexture();
+}
+
+void TextureStreamer::update() {
+    pollFences();
+
+    size_t uploaded = 0;
+    while (uploaded < uploadBudget) {
+        Entry* entry;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (decodedQueue.empty())
+                break;
+            entry = decodedQueue.front();
+        }
+        size_t size = uploadSize(*entry);
+        if (uploaded > 0 && uploaded + size > uploadBudget)
+            break;  // ostatak sledećeg frejma
+        if (!uploadEntry(*entry))
+            break;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decodedQueue.pop_front();
+        }
+        uploaded += size;
+    }
+    if (uploaded > 0)
+        glFlush();  // da fence krene ka GPU-u i bez swap-a
+}
+
+unsigned int TextureStreamer::texture(TextureHandle handle) const {
+    if (handle < 0 || (size_t)handle >= entries.size())
+        return 0;
+    // Stanje menja i radna nit (Decoding -> Decoded/Failed/Shared)
+    std::lock_guard<std::mutex> lock(mutex);
+    const Entry& entry = owner(*entries[handle]);
+    return entry.state == State::Ready ? entry.texture : 0;
+}
+
+bool TextureStreamer::isFailed(TextureHandle handle) const {
+    if (handle < 0 || (size_t)handle >= entries.size())
+        return true;
+    std::lock_guard<std::mutex> lock(mutex);
+    const State state = owner(*entries[handle]).state;
+    return state == State::Failed || state == State::Released;
+}
+
+size_t TextureStreamer::textureBytes(TextureHandle handle) const {
+    if (handle < 0 || (size_t)handle >= entries.size())
+        return 0;
+    std::lock_guard<std::mutex> lock(mutex);
+    const Entry& entry = owner(*entries[handle]);
+    return entry.state == State::Ready ? entry.bytes : 0;
+}
+
+size_t TextureStreamer::totalBytes() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t total = 0;
+    for (const std::unique_ptr<Entry>& entry : entries) {
+        if (entry->state == State::Ready)
+            total += entry->bytes;
+    }
+    return total;
+}
+
+void TextureStreamer::printReport() const {
+    std::vector<const Entry*> loaded;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<Entry>& entry : entries) {
+            if (entry->state == State::Ready)
+                loaded.push_back(entry.get());
+        }
+    }
+    // Najveće prve
+    std::sort(loaded.begin(), loaded.end(), [](const Entry* a, const Entry* b) { return a->bytes > b->bytes; });
+
+    std::cout << "Teksture u VRAM-u (" << loaded.size() << ", ukupno " << totalBytes() / 1024 << " KB):" << std::endl;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Entry* entry : loaded) {
+        int refs = entry->refCount;
+        std::string paths = entry->path;
+        for (const std::unique_ptr<Entry>& other : entries) {
+            if (other->state == State::Shared && other->shared == entry) {
+                refs += other->refCount;
+                paths += ", " + other->path;
+            }
+        }
+        std::cout << "  " << entry->bytes / 1024 << " KB  " << entry->width << "x" << entry->height
+                  << (entry->compressedFormat ? " S3TC" : "") << "  ref " << refs << "  " << paths << std::endl;
+    }
+}
+
+void TextureStreamer::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        decodeQueue.clear();
+        decodedQueue.clear();
+    }
+    decodeSignal.notify_all();
+    for (std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+
+    for (PixelBuffer& pixelBuffer : pixelBuffers) {
+        if (pixelBuffer.fence)
+            glDeleteSync(pixelBuffer.fence);
+        glDeleteBuffers(1, &pixelBuffer.buffer);
+    }
+    pixelBuffers.clear();
+    for (std::unique_ptr<Entry>& entry : entries) {
+        if (entry->texture)
+            glDeleteTextures(1, &entry->texture);
+        entry->texture = 0;
+    }
+}
@@ -0,0 +1,23 @@
+#include "../Header/Transform.h"
+
+#include <cmath>
+
+bool hasUniformScale(const glm::mat3& linear) {
+    const float xx = glm::dot(linear[0], linear[0]);
+    const float yy = glm::dot(linear[1], linear[1]);
+    const float zz = glm::dot(linear[2], linear[2]);
+    // Kolone moraju biti iste dužine i međusobno normalne (tolerancija relativna u odnosu na s²)
+    const float tolerance = 1e-5f * xx;
+    return xx > 0.0f &&
+           std::fabs(xx - yy) <= tolerance && std::fabs(xx - zz) <= tolerance &&
+           std::fabs(glm::dot(linear[0], linear[1])) <= tolerance &&
+           std::fabs(glm::dot(linear[0], linear[2])) <= tolerance &&
+           std::fabs(glm::dot(linear[1], linear[2])) <= tolerance;
+}
+
+glm::mat3 normalMatrix(const glm::mat4& model) {
+    const glm::mat3 linear(model);
+    if (hasUniformScale(linear))
+        return linear * (1.0f / glm::dot(linear[0], linear[0]));
+    return glm::transpose(glm::inverse(linear));
+}
@@ -0,0 +1,90 @@
+#include "../Header/UniformBlocks.h"
+#include "../Header/Model.h"
+#include "../Header/GLTFLoader.h"
+
+#include <GL/glew.h>
+#include <iostream>
+#include <algorithm>
+
+MaterialData makeMaterialData(const Material& material) {
+    return makeMaterialData(material.Ka, material.Kd, material.Ks, material.Ns,
+                            glm::vec4(material.Kd, std::min(material.d, 1.0f)));
+}
+
+MaterialData makeMaterialData(const glm::vec3& ambient, const glm::vec3& diffuse, const glm::vec3& specular,
+                              float shininess, const glm::vec4& color) {
+    MaterialData data;
+    data.ambient = glm::vec4(ambient, 0.0f);
+    data.diffuse = glm::vec4(diffuse, 0.0f);
+    data.specular = glm::vec4(specular, shininess);
+    data.color = color;
+    return data;
+}
+
+void FrameUniformBuffer::create() {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, buffer);
+}
+
+void FrameUniformBuffer::update(const FrameData& frame) {
+    // Ceo bafer se zamenjuje (glBufferData), pa drajver ne čeka da GPU završi prethodni frejm
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &frame, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniformBuffer::destroy() {
+    if (buffer != 0)
+        glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
+
+unsigned int MaterialUniformBuffer::add(const MaterialData& material) {
+    if (materials.size() >= MAX_MATERIALS) {
+        std::cout << "Previse materijala za uniform blok (najvise " << MAX_MATERIALS << ")" << std::endl;
+        return 0;
+    }
+    materials.push_back(material);
+    return (unsigned int)materials.size() - 1;
+}
+
+unsigned int MaterialUniformBuffer::addMaterials(const std::vector<Material>& modelMaterials) {
+    if (materials.size() + modelMaterials.size() > MAX_MATERIALS) {
+        std::cout << "Previse materijala za uniform blok (najvise " << MAX_MATERIALS << ")" << std::endl;
+        return 0;
+    }
+    unsigned int base = (unsigned int)materials.size();
+    for (const Material& material : modelMaterials)
+        materials.push_back(makeMaterialData(material));
+    return base;
+}
+
+void MaterialUniformBuffer::addModel(OBJModel& model) {
+    model.materialBase = addMaterials(model.materials);
+}
+
+void MaterialUniformBuffer::addModel(GLTFModel& model) {
+    model.materialBase = addMaterials(model.materials);
+}
+
+void MaterialUniformBuffer::upload() {
+    if (buffer == 0)
+        glGenBuffers(1, &buffer);
+    // Uvek pun niz, da indeksi van opsega čitaju nule umesto memorije van bafera
+    const glm::vec3 black(0.0f);
+    std::vector<MaterialData> block(MAX_MATERIALS, makeMaterialData(black, black, black, 0.0f, glm::vec4(0.0f)));
+    std::copy(materials.begin(), materials.end(), block.begin());
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, block.size() * sizeof(MaterialData), block.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BLOCK_BINDING, buffer);
+}
+
+void MaterialUniformBuffer::destroy() {
+    if (buffer != 0)
+        glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
@@ -5,6 +5,7 @@
 #include <sstream>
 #include <iostream>
 #include <glm/glm.hpp>
+#include "../Header/ImageOps.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../Header/stb_image.h"
@@ -20,7 +21,7 @@ int endProgram(std::string message) {
     return -1;
 }
 
-unsigned int compileShader(GLenum type, const char* source)
+unsigned int compileShader(GLenum type, const char* source, const char* defines)
 {
     //Uzima kod u fajlu na putanji "source", kompajlira ga i vraca sejder tipa "type"
     //Citanje izvornog koda iz fajla
@@ -38,6 +39,15 @@ unsigned int compileShader(GLenum type, const char* source)
         std::cout << "Greska pri citanju fajla sa putanje \"" << source << "\"!" << std::endl;
     }
     std::string temp = ss.str();
+    if (defines && *defines)
+    {
+        //#version mora ostati prva linija, pa se definicije ubacuju iza nje; #line vraca numeraciju za poruke o greskama
+        size_t versionEnd = temp.compare(0, 8, "#version") == 0 ? temp.find('\n') : std::string::npos;
+        if (versionEnd == std::string::npos)
+            temp = std::string(defines) + "#line 1\n" + temp;
+        else
+            temp.insert(versionEnd + 1, std::string(defines) + "#line 2\n");
+    }
     const char* sourceCode = temp.c_str(); //Izvorni kod sejdera koji citamo iz fajla na putanji "source"
 
     int shader = glCreateShader(type); //Napravimo prazan sejder odredjenog tipa (vertex ili fragment)
@@ -60,7 +70,7 @@ unsigned int compileShader(GLenum type, const char* source)
     }
     return shader;
 }
-unsigned int createShader(const char* vsSource, const char* fsSource)
+unsigned int createShader(const char* vsSource, const char* fsSource, const char* defines)
 {
     //Pravi objedinjeni sejder program koji se sastoji od Vertex sejdera ciji je kod na putanji vsSource
 
@@ -70,8 +80,8 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
 
     program = glCreateProgram(); //Napravi prazan objedinjeni sejder program
 
-    vertexShader = compileShader(GL_VERTEX_SHADER, vsSource); //Napravi i kompajliraj vertex sejder
-    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsSource); //Napravi i kompajliraj fragment sejder
+    vertexShader = compileShader(GL_VERTEX_SHADER, vsSource, defines); //Napravi i kompajliraj vertex sejder
+    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsSource, defines); //Napravi i kompajliraj fragment sejder
 
     //Zakaci verteks i fragment sejdere za objedinjeni program
     glAttachShader(program, vertexShader);
@@ -99,94 +109,132 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     return program;
 }
 
-unsigned loadImageToTexture(const char* filePath) {
-    int TextureWidth;
-    int TextureHeight;
-    int TextureChannels;
-    unsigned char* ImageData = stbi_load(filePath, &TextureWidth, &TextureHeight, &TextureChannels, 0);
-    if (ImageData != NULL)
-    {
-        //Slike se osnovno ucitavaju naopako pa se moraju ispraviti da budu uspravne
-        stbi__vertical_flip(ImageData, TextureWidth, TextureHeight, TextureChannels);
-
-        // Provjerava koji je format boja ucitane slike
-        GLint InternalFormat = -1;
-        switch (TextureChannels) {
-        case 1: InternalFormat = GL_RED; break;
-        case 2: InternalFormat = GL_RG; break;
-        case 3: InternalFormat = GL_RGB; break;
-        case 4: InternalFormat = GL_RGBA; break;
-        default: InternalFormat = GL_RGB; break;
-        }
+DecodedImage::~DecodedImage() {
+    if (pixels)
+        stbi_image_free(pixels);
+}
+
+DecodedImage::DecodedImage(DecodedImage&& other) noexcept
+    : width(other.width), height(other.height), channels(other.channels), pixels(other.pixels) {
+    other.pixels = nullptr;
+}
 
-        unsigned int Texture;
-        glGenTextures(1, &Texture);
-        glBindTexture(GL_TEXTURE_2D, Texture);
-        glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, TextureWidth, TextureHeight, 0, InternalFormat, GL_UNSIGNED_BYTE, ImageData);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-        glBindTexture(GL_TEXTURE_2D, 0);
-        // oslobadjanje memorije zauzete sa stbi_load posto vise nije potrebna
-        stbi_image_free(ImageData);
-        return Texture;
+DecodedImage& DecodedImage::operator=(DecodedImage&& other) noexcept {
+    if (this != &other) {
+        if (pixels)
+            stbi_image_free(pixels);
+        width = other.width;
+        height = other.height;
+        channels = other.channels;
+        pixels = other.pixels;
+        other.pixels = nullptr;
     }
-    else
+    return *this;
+}
+
+bool decodeTextureImage(const char* filePath, DecodedImage& image) {
+    image = DecodedImage();
+    image.pixels = stbi_load(filePath, &image.width, &image.height, &image.channels, 0);
+    if (image.pixels == NULL)
     {
         std::cout << "Textura nije ucitana! Putanja texture: " << filePath << std::endl;
-        stbi_image_free(ImageData);
+        return false;
+    }
+    //Slike se osnovno ucitavaju naopako pa se moraju ispraviti da budu uspravne
+    flipRowsVertical(image.pixels, image.width, image.height, image.channels);
+    // RGB se širi u RGBA: drajveri ga ionako tako čuvaju, a RGBA redovi su uvek poravnati na 4 bajta
+    if (image.channels == 3) {
+        unsigned char* rgba = (unsigned char*)STBI_MALLOC((size_t)image.width * image.height * 4);
+        if (rgba) {
+            expandToRGBA(image.pixels, 3, (size_t)image.width * image.height, rgba);
+            stbi_image_free(image.pixels);
+            image.pixels = rgba;
+            image.channels = 4;
+        }
+    }
+    return true;
+}
+
+unsigned createTextureFromImage(const DecodedImage& image) {
+    if (image.pixels == NULL)
         return 0;
+
+    // Provjerava koji je format boja ucitane slike
+    GLint InternalFormat = -1;
+    switch (image.channels) {
+    case 1: InternalFormat = GL_RED; break;
+    case 2: InternalFormat = GL_RG; break;
+    case 3: InternalFormat = GL_RGB; break;
+    case 4: InternalFormat = GL_RGBA; break;
+    default: InternalFormat = GL_RGB; break;
     }
+
+    unsigned int Texture;
+    glGenTextures(1, &Texture);
+    glBindTexture(GL_TEXTURE_2D, Texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, InternalFormat, image.width, image.height, 0, InternalFormat, GL_UNSIGNED_BYTE, image.pixels);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return Texture;
 }
 
-GLFWcursor* loadImageToCursor(const char* filePath) {
+unsigned loadImageToTexture(const char* filePath) {
+    DecodedImage image;
+    if (!decodeTextureImage(filePath, image))
+        return 0;
+    // stbi memorija se oslobadja u destruktoru slike posto vise nije potrebna
+    return createTextureFromImage(image);
+}
+
+bool decodeCursorImage(const char* filePath, DecodedImage& image) {
     int w, h, ch;
     unsigned char* img = stbi_load(filePath, &w, &h, &ch, 4);
     if (!img) {
         std::cout << "Kursor nije ucitan! " << filePath << "\n";
-        return nullptr;
+        return false;
     }
 
-    // ===========================================
-    // Resize na 32�32 (ili promeni na 48 ili 64)
-    // ===========================================
+    // Resize na 32x32 area filterom (veće veličine i keš na disku: CursorCache.h)
     const int newW = 32;
     const int newH = 32;
 
-    unsigned char* resized = new unsigned char[newW * newH * 4];
-
-    // najprostije bilinear skaliranje
-    for (int y = 0; y < newH; y++) {
-        for (int x = 0; x < newW; x++) {
-
-            float gx = (float)x / (float)newW * (w - 1);
-            float gy = (float)y / (float)newH * (h - 1);
-
-            int gxi = (int)gx;
-            int gyi = (int)gy;
-
-            for (int c = 0; c < 4; c++) {
-                resized[(y * newW + x) * 4 + c] =
-                    img[(gyi * w + gxi) * 4 + c];
-            }
-        }
-    }
+    // Isti alokator kao stbi, da destruktor slike može da ga oslobodi
+    unsigned char* resized = (unsigned char*)STBI_MALLOC(newW * newH * 4);
+    resizeAreaRGBA(img, w, h, resized, newW, newH);
 
     stbi_image_free(img);
 
-    GLFWimage image;
+    image = DecodedImage();
     image.width = newW;
     image.height = newH;
+    image.channels = 4;
     image.pixels = resized;
+    return true;
+}
+
+GLFWcursor* createCursorFromImage(const DecodedImage& image) {
+    if (image.pixels == NULL)
+        return nullptr;
+
+    GLFWimage glfwImage;
+    glfwImage.width = image.width;
+    glfwImage.height = image.height;
+    glfwImage.pixels = image.pixels;
 
     // hotspot = centar
-    int hotspotX = newW / 2;
-    int hotspotY = newH / 2;
+    int hotspotX = image.width / 2;
+    int hotspotY = image.height / 2;
 
-    GLFWcursor* cursor = glfwCreateCursor(&image, hotspotX, hotspotY);
+    return glfwCreateCursor(&glfwImage, hotspotX, hotspotY);
+}
 
-    delete[] resized;
-    return cursor;
+GLFWcursor* loadImageToCursor(const char* filePath) {
+    DecodedImage image;
+    if (!decodeCursorImage(filePath, image))
+        return nullptr;
+    return createCursorFromImage(image);
 }
@@ -0,0 +1,152 @@
+#include "../Header/VertexFormat.h"
+#include "../Header/ShaderProgram.h"
+#include "../Header/Util.h"
+
+#include <cmath>
+#include <cstring>
+
+VertexQuantization makeVertexQuantization(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    VertexQuantization quantization;
+    quantization.bias = boundsMin;
+    for (int axis = 0; axis < 3; ++axis) {
+        float extent = boundsMax[axis] - boundsMin[axis];
+        quantization.scale[axis] = extent > 0.0f ? extent : 1.0f;
+    }
+    return quantization;
+}
+
+static uint16_t quantizeUnorm16(float value) {
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return (uint16_t)(value * 65535.0f + 0.5f);
+}
+
+static int16_t quantizeSnorm16(float value) {
+    value = std::min(std::max(value, -1.0f), 1.0f);
+    return (int16_t)std::lround(value * 32767.0f);
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t absBits = bits & 0x7FFFFFFFu;
+
+    if (absBits >= 0x7F800000u)  // Inf / NaN
+        return (uint16_t)(sign | (absBits > 0x7F800000u ? 0x7E00u : 0x7C00u));
+    if (absBits >= 0x477FF000u)  // >= 65520 se zaokružuje na beskonačno
+        return (uint16_t)(sign | 0x7C00u);
+    if (absBits < 0x38800000u) {
+        // Subnormalni half (ili nula): mantisa sa implicitnom jedinicom pomerena u 2^-24 jedinice
+        if (absBits < 0x33000000u)
+            return (uint16_t)sign;
+        uint32_t exponent = absBits >> 23;
+        uint32_t mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1)))
+            ++half;
+        return (uint16_t)(sign | half);
+    }
+
+    // Normalan broj: eksponent 127 -> 15, zaokruživanje na najbliži paran
+    uint32_t half = (absBits - 0x38000000u) >> 13;
+    uint32_t remainder = absBits & 0x1FFFu;
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1)))
+        ++half;
+    return (uint16_t)(sign | half);
+}
+
+void octEncodeNormal(const glm::vec3& normal, int16_t out[2]) {
+    float sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (sum <= 0.0f) {
+        // Neispravna normala – ista podrazumevana (0, 1, 0) kao pri parsiranju
+        out[0] = 0;
+        out[1] = 32767;
+        return;
+    }
+    float x = normal.x / sum, y = normal.y / sum;
+    if (normal.z < 0.0f) {
+        // Donja polusfera se preklapa preko dijagonala oktaedra
+        float foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    out[0] = quantizeSnorm16(x);
+    out[1] = quantizeSnorm16(y);
+}
+
+PackedVertex packVertex(const glm::vec3& position, const glm::vec2& texCoord, const glm::vec3& normal, const VertexQuantization& quantization) {
+    PackedVertex vertex;
+    glm::vec3 unit = (position - quantization.bias) / quantization.scale;
+    vertex.position[0] = quantizeUnorm16(unit.x);
+    vertex.position[1] = quantizeUnorm16(unit.y);
+    vertex.position[2] = quantizeUnorm16(unit.z);
+    vertex.position[3] = 0;
+    octEncodeNormal(normal, vertex.normal);
+    vertex.texCoord[0] = floatToHalf(texCoord.x);
+    vertex.texCoord[1] = floatToHalf(texCoord.y);
+    return vertex;
+}
+
+glm::vec3 unpackPosition(const PackedVertex& vertex, const VertexQuantization& quantization) {
+    glm::vec3 unit(vertex.position[0] / 65535.0f, vertex.position[1] / 65535.0f, vertex.position[2] / 65535.0f);
+    return unit * quantization.scale + quantization.bias;
+}
+
+std::vector<PackedVertex> packInterleavedVertices(const float* vertices, size_t vertexCount, VertexQuantization& quantization) {
+    const size_t stride = 12;  // pos(3) + color(4) + tex(2) + normal(3)
+    std::vector<PackedVertex> packed;
+    if (vertexCount == 0)
+        return packed;
+
+    glm::vec3 boundsMin(vertices[0], vertices[1], vertices[2]), boundsMax = boundsMin;
+    for (size_t i = 1; i < vertexCount; ++i) {
+        glm::vec3 position(vertices[i * stride], vertices[i * stride + 1], vertices[i * stride + 2]);
+        boundsMin = glm::min(boundsMin, position);
+        boundsMax = glm::max(boundsMax, position);
+    }
+    quantization = makeVertexQuantization(boundsMin, boundsMax);
+
+    packed.reserve(vertexCount);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* v = vertices + i * stride;
+        packed.push_back(packVertex(glm::vec3(v[0], v[1], v[2]), glm::vec2(v[7], v[8]), glm::vec3(v[9], v[10], v[11]), quantization));
+    }
+    return packed;
+}
+
+std::vector<uint16_t> narrowIndices(const unsigned int* indices, size_t indexCount) {
+    std::vector<uint16_t> narrow(indexCount);
+    for (size_t i = 0; i < indexCount; ++i)
+        narrow[i] = (uint16_t)indices[i];
+    return narrow;
+}
+
+unsigned int indexTypeForSize(unsigned int indexSize) {
+    return indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+void setPackedVertexAttributes() {
+    const GLsizei stride = sizeof(PackedVertex);
+    glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, texCoord));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(3, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(3);
+}
+
+VertexQuantizationUniforms findVertexQuantizationUniforms(const ShaderProgram& program) {
+    VertexQuantizationUniforms uniforms;
+    uniforms.scale = program.uniform("uPosScale");
+    uniforms.bias = program.uniform("uPosBias");
+    return uniforms;
+}
+
+void setVertexQuantizationUniforms(ShaderProgram& program, const VertexQuantizationUniforms& uniforms, const VertexQuantization& quantization) {
+    program.set(uniforms.scale, quantization.scale);
+    program.set(uniforms.bias, quantization.bias);
+}
@@ -1,64 +1,89 @@
 #version 330 core
+// Permutacije se biraju #define-ovima pri prevođenju (vidi ShaderVariants.h):
+//   USE_TEXTURE – boja iz uTex, TRANSPARENT – odbacuje skoro providne fragmente, UNLIT – overlay bez osvetljenja,
+//   INSTANCED – boja se množi bojom instance, MULTI_DRAW – materijal po komandi iz basic.vert umesto uMaterialIndex
 
 in vec2 chTex;
 in vec3 FragPos;
 in vec3 Normal;
+#ifdef INSTANCED
+in vec4 chTint;
+#endif
+#ifdef MULTI_DRAW
+flat in int chMaterialIndex;
+#endif
 
 out vec4 outCol;
 
 uniform sampler2D uTex;
-uniform vec4 uColor;
-uniform bool useTex;
-uniform bool transparent;
-uniform bool overlayMode;  // kada true: samo tekstura * uColor, bez osvetljenja (za 2D overlay)
 
-// Osvetljenje
-uniform vec3 uLightPos;
-uniform vec3 uViewPos;
-uniform vec3 uLightColor;
+// Osvetljenje (isti blok kao u basic.vert)
+layout(std140) uniform FrameBlock
+{
+    mat4 uV;
+    mat4 uP;
+    vec4 uLightPos;
+    vec4 uViewPos;
+    vec4 uLightColor;
+};
 
-// Materijal
-uniform vec3 uMaterialAmbient;
-uniform vec3 uMaterialDiffuse;
-uniform vec3 uMaterialSpecular;
-uniform float uMaterialShininess;
+// Svi materijali scene, učitani jednom; crtanje bira materijal preko uMaterialIndex (vidi UniformBlocks.h)
+#define MAX_MATERIALS 256
+struct MaterialData
+{
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular;  // w = shininess
+    vec4 color;     // boja bez teksture i providnost
+};
+layout(std140) uniform MaterialBlock
+{
+    MaterialData uMaterials[MAX_MATERIALS];
+};
+uniform int uMaterialIndex;
 
 void main()
 {
-    vec3 color = uColor.rgb;
-    vec4 texCol = vec4(1.0);
-    if (useTex)
-    {
-        texCol = texture(uTex, chTex);
-        color = texCol.rgb;
-    }
+#ifdef MULTI_DRAW
+    MaterialData material = uMaterials[chMaterialIndex];
+#else
+    MaterialData material = uMaterials[uMaterialIndex];
+#endif
+
+#ifdef UNLIT
+    // Overlay: samo tekstura * boja, bez osvetljenja (slova ostaju oštra i vidljiva)
+    outCol = texture(uTex, chTex) * material.color;
+#else
+#ifdef USE_TEXTURE
+    vec3 color = texture(uTex, chTex).rgb;
+#else
+    vec3 color = material.color.rgb;
+#endif
+#ifdef INSTANCED
+    color *= chTint.rgb;
+#endif
 
-    // Overlay režim: samo tekstura * uColor, bez osvetljenja (slova ostaju oštra i vidljiva)
-    if (overlayMode && useTex)
-    {
-        outCol = texCol * uColor;
-        return;
-    }
+#ifdef TRANSPARENT
+    if (material.color.a < 0.01)
+        discard;
+#endif
 
     // Ambient
-    vec3 ambient = uMaterialAmbient * uLightColor;
+    vec3 ambient = material.ambient.rgb * uLightColor.rgb;
     
     // Diffuse
     vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(uLightPos - FragPos);
+    vec3 lightDir = normalize(uLightPos.xyz - FragPos);
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * uMaterialDiffuse * uLightColor;
+    vec3 diffuse = diff * material.diffuse.rgb * uLightColor.rgb;
     
     // Specular
-    vec3 viewDir = normalize(uViewPos - FragPos);
+    vec3 viewDir = normalize(uViewPos.xyz - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
-    float spec = pow(max(dot(viewDir, reflectDir), 0.0), uMaterialShininess);
-    vec3 specular = spec * uMaterialSpecular * uLightColor;
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.specular.w);
+    vec3 specular = spec * material.specular.rgb * uLightColor.rgb;
     
     vec3 result = (ambient + diffuse + specular) * color;
-    
-    if (transparent && uColor.a < 0.01)
-        discard;
-
-    outCol = vec4(result, uColor.a);
+    outCol = vec4(result, material.color.a);
+#endif
 }
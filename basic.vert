@@ -1,22 +1,78 @@
 #version 330 core
+// Permutacije (USE_TEXTURE, TRANSPARENT, UNLIT, INSTANCED, MULTI_DRAW) se biraju #define-ovima pri prevođenju, vidi ShaderVariants.h
 
+// Kompaktan vertex (vidi VertexFormat.h): unorm16 pozicija, half-float UV, oktaedarska snorm16 normala
 layout(location = 0) in vec3 inPos;
-layout(location = 1) in vec4 inCol;
 layout(location = 2) in vec2 inTex;
-layout(location = 3) in vec3 inNorm;
+layout(location = 3) in vec2 inNormOct;
+// Nekvantizovana normala (GLB modeli, vidi GLTFLoader.h)
+layout(location = 1) in vec3 inNorm;
+#ifdef INSTANCED
+// Po instanci (vidi InstancedMesh.h); mat4 zauzima lokacije 4–7
+layout(location = 4) in mat4 inModel;
+layout(location = 8) in vec4 inTint;
+out vec4 chTint;
+#endif
+#ifdef MULTI_DRAW
+// Indeks materijala po komandi glMultiDrawElementsIndirect (baseInstance bira element, vidi MultiDraw.h)
+layout(location = 9) in int inMaterialIndex;
+flat out int chMaterialIndex;
+#endif
 
 out vec2 chTex;
 out vec3 FragPos;
 out vec3 Normal;
 
 uniform mat4 uM;
-uniform mat4 uV;
-uniform mat4 uP;
+uniform mat3 uNormalMatrix;  // transpose(inverse(mat3(uM))), računa se na CPU jednom po objektu (vidi Transform.h)
+
+// Kamera i svetlo, jednom po frejmu (vidi UniformBlocks.h)
+layout(std140) uniform FrameBlock
+{
+    mat4 uV;
+    mat4 uP;
+    vec4 uLightPos;
+    vec4 uViewPos;
+    vec4 uLightColor;
+};
+
+// Dekvantizacija pozicije: inPos je u [0, 1] unutar granica modela
+uniform vec3 uPosScale;
+uniform vec3 uPosBias;
+uniform bool uFloatNormals;  // true: normala iz inNorm umesto iz inNormOct
+
+vec3 octDecode(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.x += (n.x >= 0.0) ? -t : t;
+    n.y += (n.y >= 0.0) ? -t : t;
+    return normalize(n);
+}
 
 void main()
 {
+    vec3 pos = inPos * uPosScale + uPosBias;
     chTex = inTex;
-    FragPos = vec3(uM * vec4(inPos, 1.0));
-    Normal = mat3(transpose(inverse(uM))) * inNorm;
-    gl_Position = uP * uV * uM * vec4(inPos, 1.0);
+#ifdef MULTI_DRAW
+    chMaterialIndex = inMaterialIndex;
+#endif
+#ifdef UNLIT
+    // 2D overlay: uM vodi direktno u clip prostor, bez kamere i normala
+    FragPos = vec3(0.0);
+    Normal = vec3(0.0, 0.0, 1.0);
+    gl_Position = uM * vec4(pos, 1.0);
+#else
+#ifdef INSTANCED
+    // Instance imaju samo rotaciju, translaciju i uniformno skaliranje, pa je mat3(inModel) matrica normala
+    // do na dužinu (normala se normalizuje u basic.frag; vidi Transform.h)
+    FragPos = vec3(inModel * vec4(pos, 1.0));
+    Normal = mat3(inModel) * (uFloatNormals ? inNorm : octDecode(inNormOct));
+    chTint = inTint;
+#else
+    FragPos = vec3(uM * vec4(pos, 1.0));
+    Normal = uNormalMatrix * (uFloatNormals ? inNorm : octDecode(inNormOct));
+#endif
+    gl_Position = uP * uV * vec4(FragPos, 1.0);
+#endif
 }